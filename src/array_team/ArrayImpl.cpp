@@ -2,18 +2,34 @@
 // High-performance version with skill-based matching
 
 #include "ArrayImpl.hpp"
+#include "ArrayMatching.hpp"
+#include "ArrayServer.hpp"
+#include "../shared/StringPool.hpp"
+#include "../shared/Resume.hpp"
+#include "../shared/Snapshot.hpp"
+#include "../shared/BoundedQueue.hpp"
+#include "../shared/Rcu.hpp"
+#include "../shared/PerfCounters.hpp"
+#include "../shared/Tracer.hpp"
+#include "../shared/TextSource.hpp"
+#include "../shared/SkillQuery.hpp"
+#include "TextIndex.hpp"
 #include <iostream>
 #include <fstream>
 #include <string>
 #include <chrono>
 #include <iomanip>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <vector>
 
 namespace arr {
 
 // Limits
 static const int MAX_JOBS    = 20000;
 static const int MAX_RESUMES = 20000;
-static const int MAX_WORDS   = 256;
 
 // Utilities
 static inline char toLowerChar(char c) { 
@@ -27,10 +43,6 @@ static inline std::string toLower(const std::string &s) {
     return out;
 }
 
-static inline bool isWordChar(char c) {
-    return (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c=='+' || c=='#';
-}
-
 static inline std::string rtrim(std::string s){
     while (!s.empty() && (s.back()=='\r' || s.back()=='\n' || s.back()==' ' || s.back()=='\t')) 
         s.pop_back();
@@ -43,123 +55,202 @@ static inline std::string ltrim(const std::string &s){
     return s.substr(i);
 }
 
-// Tiny string array (no STL)
-struct StringArray {
-    std::string data[MAX_WORDS];
+// Expanded skills (lowercase)
+static const char* COMMON_SKILLS[] = {
+    "c++","python","java","javascript","sql","html","css",
+    "react","node.js","mongodb","mysql","postgresql",
+    "git","docker","kubernetes","aws","azure","gcp",
+    "machine learning","deep learning","nlp","pandas","numpy",
+    "excel","power bi","tableau","data analysis","data cleaning",
+    "statistics","tensorflow","pytorch","rest api","rest apis",
+    "spring","spring boot","django","flask","angular","vue.js",
+    "system design","mlops","keras","computer vision",
+    "stakeholder management","user stories","product roadmap",
+    "agile","scrum","reporting","bi","etl","data warehouse",
+    "leadership","communication","problem solving","teamwork"
+};
+static const int SKILL_COUNT = sizeof(COMMON_SKILLS)/sizeof(COMMON_SKILLS[0]);
+static_assert(SKILL_COUNT <= 64, "skill masks hold at most 64 skills");
+
+// Extracted skills as indices into COMMON_SKILLS (no STL)
+struct SkillList {
+    unsigned char ids[SKILL_COUNT];
     int _size = 0;
     void clear(){ _size = 0; }
     int  size() const { return _size; }
-    std::string& operator[](int i){ return data[i]; }
-    const std::string& operator[](int i) const { return data[i]; }
-    void push_back(const std::string &s){ 
-        if (_size < MAX_WORDS) data[_size++] = s; 
+    const char* name(int i) const { return COMMON_SKILLS[ids[i]]; }
+    void push_back(int skill){
+        if (_size < SKILL_COUNT) ids[_size++] = (unsigned char)skill; 
     }
 };
 
-static inline bool contains(const StringArray &arr, const std::string &w){
-    for (int i=0;i<arr.size();i++) if (arr[i]==w) return true;
-    return false;
-}
-
-// Domain structures
+// Domain structures. Descriptions and summaries are only needed for
+// display: a record keeps where its text is, and the text stays in the
+// store's TextSource (the mapped snapshot) until it is shown.
 struct JobA {
     int id = 0;
-    std::string title;
-    std::string company;
-    std::string description;
+    const std::string* title = nullptr;      // interned in StringPool::shared()
+    const std::string* company = nullptr;    // interned
+    TextRef description;                     // in ArrayStore::jobText
     int years = 0;
-    StringArray skills;
+    SkillList skills;
+    unsigned long long skillMask = 0;        // same skills as a COMMON_SKILLS bit mask
     
     void display() const {
-        std::cout << "[" << id << "] " << title
-                  << " @ " << company << "  (" << years << " yrs)\n";
+        std::cout << "[" << id << "] " << *title
+                  << " @ " << *company << "  (" << years << " yrs)\n";
     }
     
-    void displayDetailed() const {
+    void displayDetailed(const TextSource& text) const {
         display();
         std::cout << "Skills: ";
         for (int i=0;i<skills.size();++i){
             if (i) std::cout << ", ";
-            std::cout << skills.data[i];
+            std::cout << skills.name(i);
         }
-        std::cout << "\nDescription: " << description << "\n";
+        std::cout << "\nDescription: " << text.get(description) << "\n";
     }
 };
 
 struct ResumeA {
     int id = 0;
-    std::string name;
-    std::string email;
-    std::string summary;
+    TextRef summary;         // in ArrayStore::resumeText; name and email are generated from the id
     int years = 0;
-    StringArray skills;
+    SkillList skills;
+    unsigned long long skillMask = 0;
     
     void display() const {
-        std::cout << "[" << id << "] " << name
-                  << " <" << email << ">  (" << years << " yrs)\n";
+        std::cout << "[" << id << "] " << Resume::candidateName(id)
+                  << " <" << Resume::candidateEmail(id) << ">  (" << years << " yrs)\n";
     }
     
-    void displayDetailed() const {
+    void displayDetailed(const TextSource& text) const {
         display();
         std::cout << "Skills: ";
         for (int i=0;i<skills.size();++i){
             if (i) std::cout << ", ";
-            std::cout << skills.data[i];
+            std::cout << skills.name(i);
         }
-        std::cout << "\nSummary: " << summary << "\n";
+        std::cout << "\nSummary: " << text.get(summary) << "\n";
     }
 };
 
-struct BestMatch {
-    int jobId = -1;
-    double score = 0.0;
-    int matchedSkills = 0;
-};
-
-// Expanded skills (lowercase)
-static const char* COMMON_SKILLS[] = {
-    "c++","python","java","javascript","sql","html","css",
-    "react","node.js","mongodb","mysql","postgresql",
-    "git","docker","kubernetes","aws","azure","gcp",
-    "machine learning","deep learning","nlp","pandas","numpy",
-    "excel","power bi","tableau","data analysis","data cleaning",
-    "statistics","tensorflow","pytorch","rest api","rest apis",
-    "spring","spring boot","django","flask","angular","vue.js",
-    "system design","mlops","keras","computer vision",
-    "stakeholder management","user stories","product roadmap",
-    "agile","scrum","reporting","bi","etl","data warehouse",
-    "leadership","communication","problem solving","teamwork"
-};
-static const int SKILL_COUNT = sizeof(COMMON_SKILLS)/sizeof(COMMON_SKILLS[0]);
-
-static void extractSkills(const std::string& text, StringArray &out){
+// Returns the extracted skills as a vocabulary bit mask (bit i = COMMON_SKILLS[i])
+static unsigned long long extractSkills(const std::string& text, SkillList &out){
     std::string low = toLower(text);
     out.clear();
+    unsigned long long mask = 0;
     for (int i=0;i<SKILL_COUNT;i++){
-        std::string needle = COMMON_SKILLS[i];
-        if (low.find(needle) != std::string::npos){
-            bool alreadyAdded = false;
-            for (int j=0; j<out.size(); j++){
-                if (out[j] == needle){
-                    alreadyAdded = true;
-                    break;
-                }
-            }
-            if (!alreadyAdded) out.push_back(needle);
+        if (low.find(COMMON_SKILLS[i]) != std::string::npos){
+            out.push_back(i);
+            mask |= 1ULL << i;
         }
     }
+    return mask;
+}
+
+// Rebuild a skill list from a mask (same order as extractSkills)
+static void skillsFromMask(unsigned long long mask, SkillList &out){
+    out.clear();
+    for (int i=0;i<SKILL_COUNT;i++){
+        if (mask & (1ULL << i)) out.push_back(i);
+    }
 }
 
+// Word index of one side's text. Loading from CSV builds it while the text
+// is in memory anyway; a snapshot load only notes where each record's text
+// is, and the index is built from the mapping on the first keyword search,
+// so startup never reads the text.
+class WordIndex {
+private:
+    std::shared_ptr<const TextSource> text;
+    std::vector<int> ids;
+    std::vector<TextRef> refs;
+    mutable std::once_flag once;
+    mutable std::shared_ptr<const TextIndex> index;
+    mutable std::atomic<bool> ready;
+
+public:
+    explicit WordIndex(std::shared_ptr<const TextIndex> built)
+        : index(std::move(built)), ready(true) {}
+    WordIndex(std::shared_ptr<const TextSource> text, std::vector<int> ids, std::vector<TextRef> refs)
+        : text(std::move(text)), ids(std::move(ids)), refs(std::move(refs)), ready(false) {}
+    
+    bool isBuilt() const { return ready.load(); }
+    
+    const TextIndex& get() const {
+        std::call_once(once, [this](){
+            if (!index){
+                TextIndexBuilder words;
+                for (size_t i=0;i<ids.size();i++) words.addDocument(ids[i], text->get(refs[i]));
+                index = words.finish();
+                text->evict();      // pages read for the index aren't needed for display
+            }
+            ready.store(true);
+        });
+        return *index;
+    }
+};
+
 // Storage
-static JobA    JOBS[MAX_JOBS];
-static ResumeA RESUMES[MAX_RESUMES];
+// Loaded data is immutable once published: loading, reloading and sorting
+// build a new ArrayStore and swap it in through g_store (see Rcu.hpp).
+// Readers never block, and an old version is freed once no reader is
+// still using it.
+struct ArrayStore {
+    long long version = 0;
+    JobA* jobs = nullptr;
+    int jobCount = 0;
+    ResumeA* resumes = nullptr;
+    int resumeCount = 0;
+    std::shared_ptr<const TextSource> jobText;      // descriptions
+    std::shared_ptr<const TextSource> resumeText;   // summaries
+    std::shared_ptr<const SkillQueryIndex> jobSkills;      // ids per skill, for Boolean queries
+    std::shared_ptr<const SkillQueryIndex> resumeSkills;
+    std::shared_ptr<const WordIndex> jobWords;          // words of the text, by record id
+    std::shared_ptr<const WordIndex> resumeWords;
+    
+    ArrayStore() {}
+    ~ArrayStore(){
+        delete[] jobs;
+        delete[] resumes;
+    }
+    ArrayStore(const ArrayStore&) = delete;
+    ArrayStore& operator=(const ArrayStore&) = delete;
+};
+
+static EpochDomain g_epochs;
+static RcuPtr<ArrayStore> g_store(g_epochs);
+static RcuPtr<CompactStore> g_compact(g_epochs);   // same version, for the query server
+static std::mutex g_publishLock;                  // serializes the swaps
+static std::mutex g_writerLock;                   // one derive-and-publish at a time
+static std::atomic<long long> g_nextVersion(1);
+
+// Best job per resume, by resume position in the version it was computed on
 static BestMatch BEST[MAX_RESUMES];
-static int J = 0, R = 0;
+static long long g_bestVersion = 0;     // 0 = no matching run yet
 
 static long long g_load_us  = 0;
 static long long g_match_us = 0;
+static PhaseMemory g_jobsMemory, g_resumesMemory, g_matchMemory;
+static PhaseCounters g_counters;
 
 // CSV Loader
+// Strips quotes and whitespace; returns false for lines that aren't records
+static bool cleanRecordLine(std::string &line){
+    if (line.empty()) return false;
+    
+    while (!line.empty() && (line.front() == '"' || line.front() == ' ')) {
+        line = line.substr(1);
+    }
+    while (!line.empty() && (line.back() == '"' || line.back() == '\r' || 
+                             line.back() == '\n' || line.back() == ' ')) {
+        line.pop_back();
+    }
+    
+    return !line.empty() && line.length() >= 20;
+}
+
 static int readSingleColumnQuoted(const std::string &path, std::string* out, int cap){
     std::ifstream fin(path.c_str());
     if (!fin.is_open()){
@@ -175,18 +266,8 @@ static int readSingleColumnQuoted(const std::string &path, std::string* out, int
             first=false; 
             continue;
         }
-        if (line.empty()) continue;
         
-        // Clean the line
-        while (!line.empty() && (line.front() == '"' || line.front() == ' ')) {
-            line = line.substr(1);
-        }
-        while (!line.empty() && (line.back() == '"' || line.back() == '\r' || 
-                                 line.back() == '\n' || line.back() == ' ')) {
-            line.pop_back();
-        }
-        
-        if (!line.empty() && line.length() >= 20 && n < cap) {
+        if (cleanRecordLine(line) && n < cap) {
             out[n++] = line;
         }
     }
@@ -194,19 +275,110 @@ static int readSingleColumnQuoted(const std::string &path, std::string* out, int
     return n;
 }
 
-static void loadJobs(const char* path){
-    std::string descs[MAX_JOBS];
-    J = readSingleColumnQuoted(path, descs, MAX_JOBS);
+// Binary snapshots (see Snapshot.hpp): skip parsing and extraction on later runs
+static bool loadJobsFromSnapshot(const char* path, unsigned long long sourceKey,
+                                 ArrayStore& store, std::ostream& log){
+    SnapshotReader snap;
+    if (!snap.open(Snapshot::pathFor(path, "array"), sourceKey,
+                   Snapshot::vocabularyKey(COMMON_SKILLS, SKILL_COUNT))) return false;
+    if (snap.size() > MAX_JOBS) return false;
+    
+    const std::string* company = StringPool::shared().intern("Tech Company");
+    int J = snap.size();
+    JobA* JOBS = new JobA[J > 0 ? J : 1];
+    store.jobs = JOBS;
+    store.jobCount = J;
+    store.jobText = snap.shareText();
+    std::vector<int> ids(J);
+    std::vector<TextRef> refs(J);
+    for (int i=0;i<J;i++){
+        const SnapshotRecord& r = snap.record(i);
+        JOBS[i].id = r.id;
+        JOBS[i].title = StringPool::shared().intern(snap.titleString(i));
+        JOBS[i].company = company;
+        JOBS[i].description = snap.textRef(i);
+        JOBS[i].years = r.years;
+        JOBS[i].skillMask = r.skillMask;
+        skillsFromMask(r.skillMask, JOBS[i].skills);
+        ids[i] = r.id;
+        refs[i] = JOBS[i].description;
+    }
+    store.jobWords = std::make_shared<const WordIndex>(store.jobText, std::move(ids), std::move(refs));
+    store.jobText->evict();     // titles were read from the mapping
+    log << "Loaded " << J << " jobs from snapshot\n";
+    return true;
+}
+
+static bool loadResumesFromSnapshot(const char* path, unsigned long long sourceKey,
+                                    ArrayStore& store, std::ostream& log){
+    SnapshotReader snap;
+    if (!snap.open(Snapshot::pathFor(path, "array"), sourceKey,
+                   Snapshot::vocabularyKey(COMMON_SKILLS, SKILL_COUNT))) return false;
+    if (snap.size() > MAX_RESUMES) return false;
+    
+    int R = snap.size();
+    ResumeA* RESUMES = new ResumeA[R > 0 ? R : 1];
+    store.resumes = RESUMES;
+    store.resumeCount = R;
+    store.resumeText = snap.shareText();
+    std::vector<int> ids(R);
+    std::vector<TextRef> refs(R);
+    for (int i=0;i<R;i++){
+        const SnapshotRecord& r = snap.record(i);
+        RESUMES[i].id = r.id;
+        RESUMES[i].summary = snap.textRef(i);
+        RESUMES[i].years = r.years;
+        RESUMES[i].skillMask = r.skillMask;
+        skillsFromMask(r.skillMask, RESUMES[i].skills);
+        ids[i] = r.id;
+        refs[i] = RESUMES[i].summary;
+    }
+    store.resumeWords = std::make_shared<const WordIndex>(store.resumeText, std::move(ids), std::move(refs));
+    log << "Loaded " << R << " resumes from snapshot\n";
+    return true;
+}
+
+// What loading cost, for the performance comparison
+struct LoadReport {
+    PhaseMemory jobsMemory;
+    PhaseMemory resumesMemory;
+    CounterSample read;         // CSV or snapshot reading, both files
+    CounterSample extract;      // building records and extracting skills
+};
+
+static void loadJobs(const char* path, ArrayStore& store, std::ostream& log, LoadReport* report){
+    unsigned long long sourceKey = Snapshot::sourceKey(path);
+    CounterPhase readCounters(report != nullptr);
+    traceBegin("read jobs", "load");
+    if (loadJobsFromSnapshot(path, sourceKey, store, log)){
+        traceEnd("read jobs", "load");
+        if (report) report->read.add(readCounters.finish());
+        return;
+    }
+    
+    std::string* descs = new std::string[MAX_JOBS];     // too big for the stack
+    int J = readSingleColumnQuoted(path, descs, MAX_JOBS);
+    traceEnd("read jobs", "load");
+    if (report) report->read.add(readCounters.finish());
+    CounterPhase extractCounters(report != nullptr);
+    TraceScope extractScope("extract jobs", "extract", "records", J);
+    JobA* JOBS = new JobA[J > 0 ? J : 1];
+    store.jobs = JOBS;
+    store.jobCount = J;
     int id=1;
+    SnapshotWriter snap;
+    TextIndexBuilder words;
     
-    std::cout << "Extracting job skills: ";
+    const std::string* company = StringPool::shared().intern("Tech Company");
+    
+    log << "Extracting job skills: ";
     int progressStep = J / 10;
     if (progressStep == 0) progressStep = 1;
     
     for (int i=0;i<J;i++){
         if (i % progressStep == 0) {
-            std::cout << (i * 100 / J) << "% ";
-            std::cout.flush();
+            log << (i * 100 / J) << "% ";
+            log.flush();
         }
         
         std::string d = descs[i];
@@ -223,100 +395,198 @@ static void loadJobs(const char* path){
         }
 
         JOBS[i].id = id++;
-        JOBS[i].title = title;
-        JOBS[i].company = "Tech Company";
-        JOBS[i].description = d;
+        JOBS[i].title = StringPool::shared().intern(title);
+        JOBS[i].company = company;
         JOBS[i].years = 3;
-        extractSkills(d, JOBS[i].skills);
+        JOBS[i].skillMask = extractSkills(d, JOBS[i].skills);
+        JOBS[i].description = snap.add(JOBS[i].id, JOBS[i].years, JOBS[i].skillMask, title, d);
+        words.addDocument(JOBS[i].id, d);
     }
-    std::cout << "100%\n";
+    log << "100%\n";
+    delete[] descs;
+    store.jobWords = std::make_shared<const WordIndex>(words.finish());
+    if (report) report->extract.add(extractCounters.finish());
+    
+    store.jobText = snap.writeAndShareText(Snapshot::pathFor(path, "array"), sourceKey,
+                                           Snapshot::vocabularyKey(COMMON_SKILLS, SKILL_COUNT));
 }
 
-static void loadResumes(const char* path){
-    std::string descs[MAX_RESUMES];
-    R = readSingleColumnQuoted(path, descs, MAX_RESUMES);
+static void loadResumes(const char* path, ArrayStore& store, std::ostream& log, LoadReport* report){
+    unsigned long long sourceKey = Snapshot::sourceKey(path);
+    CounterPhase readCounters(report != nullptr);
+    traceBegin("read resumes", "load");
+    if (loadResumesFromSnapshot(path, sourceKey, store, log)){
+        traceEnd("read resumes", "load");
+        if (report) report->read.add(readCounters.finish());
+        return;
+    }
+    
+    std::string* descs = new std::string[MAX_RESUMES];
+    int R = readSingleColumnQuoted(path, descs, MAX_RESUMES);
+    traceEnd("read resumes", "load");
+    if (report) report->read.add(readCounters.finish());
+    CounterPhase extractCounters(report != nullptr);
+    TraceScope extractScope("extract resumes", "extract", "records", R);
+    ResumeA* RESUMES = new ResumeA[R > 0 ? R : 1];
+    store.resumes = RESUMES;
+    store.resumeCount = R;
     int id=101;
+    SnapshotWriter snap;
+    TextIndexBuilder words;
     
-    std::cout << "Extracting resume skills: ";
+    log << "Extracting resume skills: ";
     int progressStep = R / 10;
     if (progressStep == 0) progressStep = 1;
     
     for (int i=0;i<R;i++){
         if (i % progressStep == 0) {
-            std::cout << (i * 100 / R) << "% ";
-            std::cout.flush();
+            log << (i * 100 / R) << "% ";
+            log.flush();
         }
         
         std::string d = descs[i];
         RESUMES[i].id = id;
-        RESUMES[i].name = "Candidate_" + std::to_string(id);
-        RESUMES[i].email = "candidate" + std::to_string(id) + "@email.com";
-        RESUMES[i].summary = d;
         RESUMES[i].years = 2;
-        extractSkills(d, RESUMES[i].skills);
+        RESUMES[i].skillMask = extractSkills(d, RESUMES[i].skills);
+        RESUMES[i].summary = snap.add(id, RESUMES[i].years, RESUMES[i].skillMask, "", d);
+        words.addDocument(id, d);
         id++;
     }
-    std::cout << "100%\n";
+    log << "100%\n";
+    delete[] descs;
+    store.resumeWords = std::make_shared<const WordIndex>(words.finish());
+    if (report) report->extract.add(extractCounters.finish());
+    
+    store.resumeText = snap.writeAndShareText(Snapshot::pathFor(path, "array"), sourceKey,
+                                              Snapshot::vocabularyKey(COMMON_SKILLS, SKILL_COUNT));
 }
 
-// OPTIMIZED Matching algorithms - Skill-based only (much faster)
-static int countMatchingSkills(const JobA& job, const ResumeA& res){
-    int m=0;
-    for (int i=0;i<res.skills.size();++i)
-        if (contains(job.skills, res.skills[i])) m++;
-    return m;
+// Skill bitmaps of one record set; skill index i is COMMON_SKILLS[i]
+template <typename Record>
+static std::shared_ptr<const SkillQueryIndex> buildSkillQueries(const Record* records, int count){
+    std::shared_ptr<SkillQueryIndex> index = std::make_shared<SkillQueryIndex>();
+    for (int s=0;s<SKILL_COUNT;s++) index->defineSkill(COMMON_SKILLS[s]);
+    for (int i=0;i<count;i++){
+        index->addRecord(records[i].id);
+        unsigned long long mask = records[i].skillMask;
+        while (mask){
+            index->addSkill(records[i].id, __builtin_ctzll(mask));
+            mask &= mask - 1;
+        }
+    }
+    index->finish();
+    return index;
 }
 
-// OPTIMIZED: Use skill-based matching instead of full text tokenization
-static double matchScore(const ResumeA& res, const JobA& job){
-    // If no skills extracted, use basic score
-    if (res.skills.size() == 0 && job.skills.size() == 0) return 50.0;
-    if (job.skills.size() == 0) return 30.0;
-    if (res.skills.size() == 0) return 20.0;
+// Build a new version of the data off to the side (not yet published).
+// report, if given, receives what loading cost.
+static ArrayStore* loadStore(const char* jobsPath, const char* resumesPath, std::ostream& log,
+                             LoadReport* report = nullptr){
+    ArrayStore* store = new ArrayStore;
+    store->version = g_nextVersion.fetch_add(1);
     
-    // Count matching skills
-    int overlap = 0;
-    for (int i = 0; i < res.skills.size(); ++i) {
-        if (contains(job.skills, res.skills[i])) {
-            overlap++;
-        }
-    }
+    MemoryPhase jobsPhase;
+    loadJobs(jobsPath, *store, log, report);
+    if (report) report->jobsMemory = jobsPhase.finish();
     
-    // Skill matching score (0-100)
-    double skillScore = (100.0 * overlap) / (double)job.skills.size();
+    MemoryPhase resumesPhase;
+    loadResumes(resumesPath, *store, log, report);
+    if (report) report->resumesMemory = resumesPhase.finish();
     
-    // Experience matching score (0-100)
-    double expScore = 100.0;
-    if (res.years < job.years) {
-        expScore = (res.years * 100.0) / job.years;
-        if (expScore < 0) expScore = 0;
+    store->jobSkills = buildSkillQueries(store->jobs, store->jobCount);
+    store->resumeSkills = buildSkillQueries(store->resumes, store->resumeCount);
+    return store;
+}
+
+// Deep copy, for writers that derive a new version from the current one
+static ArrayStore* copyStore(const ArrayStore& from){
+    ArrayStore* store = new ArrayStore;
+    store->version = g_nextVersion.fetch_add(1);
+    store->jobCount = from.jobCount;
+    store->jobs = new JobA[from.jobCount > 0 ? from.jobCount : 1];
+    for (int i=0;i<from.jobCount;i++) store->jobs[i] = from.jobs[i];
+    store->resumeCount = from.resumeCount;
+    store->resumes = new ResumeA[from.resumeCount > 0 ? from.resumeCount : 1];
+    for (int i=0;i<from.resumeCount;i++) store->resumes[i] = from.resumes[i];
+    store->jobText = from.jobText;
+    store->resumeText = from.resumeText;
+    store->jobSkills = from.jobSkills;          // sorting keeps ids and skills
+    store->resumeSkills = from.resumeSkills;
+    store->jobWords = from.jobWords;
+    store->resumeWords = from.resumeWords;
+    return store;
+}
+
+// Copy ids, years and skill masks into compact arrays for the matching kernels
+static void buildCompact(const ArrayStore& store, CompactRecords& jobs, CompactRecords& resumes){
+    const JobA* JOBS = store.jobs;
+    const ResumeA* RESUMES = store.resumes;
+    int J = store.jobCount, R = store.resumeCount;
+    jobs.resize(J);
+    for (int i=0;i<J;i++){
+        jobs.ids[i] = JOBS[i].id;
+        jobs.years[i] = JOBS[i].years;
+        jobs.masks[i] = JOBS[i].skillMask;
     }
+    resumes.resize(R);
+    for (int i=0;i<R;i++){
+        resumes.ids[i] = RESUMES[i].id;
+        resumes.years[i] = RESUMES[i].years;
+        resumes.masks[i] = RESUMES[i].skillMask;
+    }
+}
+
+static void publishStore(ArrayStore* store){
+    CompactStore* compact = new CompactStore;
+    compact->version = store->version;
+    buildCompact(*store, compact->jobs, compact->resumes);
+    compact->jobPositions.build(compact->jobs);
+    compact->resumePositions.build(compact->resumes);
     
-    // Weighted score: 70% skills, 30% experience
-    return (skillScore * 0.7) + (expScore * 0.3);
+    std::lock_guard<std::mutex> guard(g_publishLock);
+    g_store.publish(store);
+    g_compact.publish(compact);
 }
 
-// OPTIMIZED: Added progress indicator
-static void performFullMatching(){
-    auto t1 = std::chrono::high_resolution_clock::now();
+// Skill overlap of a pair, counted on the extracted skill lists
+static inline int countMatchingSkills(const JobA& job, const ResumeA& res){
+    return ArrayScoring::countOverlap(res.skills.ids, res.skills.size(),
+                                      job.skills.ids, job.skills.size());
+}
 
-    std::cout << "Matching progress: ";
+template <typename Scores>
+static inline typename Scores::Value matchScore(const ResumeA& res, const JobA& job){
+    return Scores::score(countMatchingSkills(job, res), job.skills.size(), res.skills.size(),
+                         job.years, res.years);
+}
+
+// Reference engine: every resume against every job on the full records
+template <typename Scores>
+static void referenceKernel(const ArrayStore& store, BestMatch* best, MatchStats& stats, bool showProgress){
+    typedef typename Scores::Value Score;
+    const JobA* JOBS = store.jobs;
+    const ResumeA* RESUMES = store.resumes;
+    int J = store.jobCount, R = store.resumeCount;
+    stats.jobClasses = 0;
+    stats.resumeClasses = 0;
+    stats.pairsScored = (long long)J * R;
+    
+    if (showProgress) std::cout << "Matching progress: ";
     int progressStep = R / 10;
     if (progressStep == 0) progressStep = 1;
 
     for (int ri=0; ri<R; ++ri){
-        // Show progress
-        if (ri % progressStep == 0) {
+        if (showProgress && ri % progressStep == 0) {
             std::cout << (ri * 100 / R) << "% ";
             std::cout.flush();
         }
         
-        double bestS = -1.0;
+        Score  bestS = Scores::none();
         int    bestJ = -1;
         int    bestK = 0;
         
         for (int ji=0; ji<J; ++ji){
-            double s = matchScore(RESUMES[ri], JOBS[ji]);
+            Score s = matchScore<Scores>(RESUMES[ri], JOBS[ji]);
             if (s > bestS){
                 bestS = s;
                 bestJ = JOBS[ji].id;
@@ -324,15 +594,339 @@ static void performFullMatching(){
             }
         }
         
-        BEST[ri].jobId = bestJ;
-        BEST[ri].score = (bestS<0?0.0:bestS);
-        BEST[ri].matchedSkills = bestK;
+        best[ri].jobId = bestJ;
+        best[ri].score = Scores::toDouble(bestS);
+        best[ri].matchedSkills = bestK;
+    }
+    
+    if (showProgress) std::cout << "100% Done!\n";
+}
+
+static void matchReference(const ArrayStore& store, BestMatch* best, MatchStats& stats, bool showProgress){
+    if (scoreMode() == SCORE_FIXED) referenceKernel<FixedScores>(store, best, stats, showProgress);
+    else referenceKernel<FloatingScores>(store, best, stats, showProgress);
+}
+
+static MatchEngine g_engine = ENGINE_DEDUP;
+
+// Run one engine into best[0..R-1]
+static void runEngine(const ArrayStore& store, MatchEngine engine, BestMatch* best,
+                      MatchStats& stats, bool showProgress){
+    if (engine == ENGINE_REFERENCE){
+        matchReference(store, best, stats, showProgress);
+        return;
+    }
+    
+    // Built per run: sorting reorders the records
+    CompactRecords jobs, resumes;
+    buildCompact(store, jobs, resumes);
+    
+    matchCompact(engine, jobs, resumes, SKILL_COUNT, best, stats, showProgress);
+}
+
+// Out-of-core matching: jobs stay resident in compact form while resumes
+// are read from the CSV in batches, so the working set doesn't grow with
+// the number of resumes. Resumes get the same ids as loadResumes() gives
+// them (101, 102, ...).
+//
+// The stages run as a pipeline on their own threads:
+//   reader -> raw -> extractors (1..n) -> extracted -> scorer -> scored -> writer
+// A fixed pool of batches circulates through the stages and back to the
+// reader via the free queue. The pool bounds memory; when a later stage
+// falls behind the reader runs out of free batches and waits, so the whole
+// pipeline runs at the pace of its slowest stage.
+
+// One batch of resumes moving through the pipeline
+struct StreamBatch {
+    long long seq = 0;              // order in the file, used by the writer
+    int count = 0;
+    int capacity = 0;
+    std::string* lines = nullptr;   // raw text, released after extraction
+    CompactRecords records;
+    BestMatch* best = nullptr;
+    
+    ~StreamBatch(){
+        delete[] lines;
+        delete[] best;
+    }
+    
+    void allocate(int cap){
+        capacity = cap;
+        lines = new std::string[cap];
+        records.resize(cap);
+        best = new BestMatch[cap];
+    }
+};
+
+// Busy time of a stage (excludes time spent waiting on queues)
+struct StageClock {
+    long long busyUs = 0;
+    std::chrono::high_resolution_clock::time_point started;
+    
+    void start(){ started = std::chrono::high_resolution_clock::now(); }
+    void stop(){
+        busyUs += std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::high_resolution_clock::now() - started).count();
+    }
+};
+
+static void performStreamingMatching(const ArrayStore& store, const char* resumesPath, long long budgetBytes){
+    const JobA* JOBS = store.jobs;
+    int J = store.jobCount;
+    MatchEngine engine = (g_engine == ENGINE_REFERENCE) ? ENGINE_DEDUP : g_engine;  // reference needs RESUMES
+    
+    int cores = (int)std::thread::hardware_concurrency();
+    int extractors = cores > 3 ? cores - 3 : 1;        // reader, scorer and writer get a core each
+    
+    // Batches in flight: queued between every pair of stages, or held by a stage
+    const int QUEUE_DEPTH = 2;
+    int poolSize = 3 * QUEUE_DEPTH + extractors + 3;
+    
+    CompactRecords jobs;
+    jobs.resize(J);
+    for (int i=0;i<J;i++){
+        jobs.ids[i] = JOBS[i].id;
+        jobs.years[i] = JOBS[i].years;
+        jobs.masks[i] = JOBS[i].skillMask;
+    }
+    BitMatrix jobSkills;
+    if (engine == ENGINE_BITMATRIX) buildSkillMatrix(jobSkills, jobs.masks, J, SKILL_COUNT);
+    
+    // Per batch: record-sized buffers plus the raw text while it is queued
+    long long jobBytes = (long long)J * engineBytesPerJob(engine);
+    long long perResume = engineBytesPerResume(engine, SKILL_COUNT) + (long long)sizeof(std::string);
+    long long batchBytes = (budgetBytes - jobBytes) / poolSize;
+    if (batchBytes < 2 * perResume){
+        std::cout << "Budget too small: jobs need " << jobBytes << " bytes and "
+                  << poolSize << " batches need at least " << (2 * perResume) << " bytes each.\n";
+        return;
+    }
+    long long batchCap = batchBytes / perResume;
+    if (batchCap > 1000000) batchCap = 1000000;
+    
+    std::ifstream fin(resumesPath);
+    if (!fin.is_open()){
+        std::cerr << "Error: Could not open " << resumesPath << "\n";
+        return;
+    }
+    std::ofstream csv("matches_array.csv");
+    csv << "ResumeID,BestJobID,Score,MatchedSkills\n";
+    
+    std::cout << "Engine: " << engineName(engine) << "\n";
+    std::cout << "Pipeline: 1 reader, " << extractors << " extractor(s), 1 scorer, 1 writer; "
+              << poolSize << " batches of up to " << batchCap << " resumes ("
+              << batchBytes << " bytes each)\n";
+    
+    StreamBatch* pool = new StreamBatch[poolSize];
+    for (int i=0;i<poolSize;i++) pool[i].allocate((int)batchCap);
+    
+    MpmcQueue<StreamBatch*> freeBatches(poolSize);
+    MpmcQueue<StreamBatch*> raw(QUEUE_DEPTH);
+    MpmcQueue<StreamBatch*> extracted(QUEUE_DEPTH, extractors);
+    SpscQueue<StreamBatch*> scored(QUEUE_DEPTH);
+    for (int i=0;i<poolSize;i++) freeBatches.push(&pool[i]);
+    
+    StageClock readClock, scoreClock, writeClock;
+    StageClock* extractClocks = new StageClock[extractors];
+    long long total = 0;
+    long long batches = 0;
+    
+    auto t1 = std::chrono::high_resolution_clock::now();
+    
+    // Reader: fill batches with raw lines until the text reaches the batch budget
+    std::thread reader([&](){
+        traceThreadName("reader");
+        std::string line;
+        bool first = true;
+        bool done = false;
+        int nextId = 101;
+        long long seq = 0;
+        
+        while (!done){
+            StreamBatch* b = nullptr;
+            freeBatches.pop(b);
+            readClock.start();
+            traceBegin("read chunk", "csv", "seq", seq);
+            
+            b->count = 0;
+            long long bytes = 0;
+            while (b->count < b->capacity && (b->count < 1 || bytes < batchBytes)){
+                if (!std::getline(fin, line)){
+                    done = true;
+                    break;
+                }
+                if (first){
+                    first = false;
+                    continue;
+                }
+                if (!cleanRecordLine(line)) continue;
+                
+                b->records.ids[b->count] = nextId++;
+                b->records.years[b->count] = 2;
+                bytes += perResume + (long long)line.size();
+                b->lines[b->count++].swap(line);
+            }
+            readClock.stop();
+            traceEnd("read chunk", "csv");
+            
+            if (b->count == 0){
+                freeBatches.push(b);
+                break;
+            }
+            b->seq = seq++;
+            raw.push(b);
+        }
+        raw.close();
+    });
+    
+    // Extractors: text -> skill masks, then drop the text
+    std::thread* extractThreads = new std::thread[extractors];
+    for (int e=0;e<extractors;e++){
+        extractThreads[e] = std::thread([&, e](){
+            traceThreadName("extractor");
+            SkillList scratch;
+            StreamBatch* b;
+            while (raw.pop(b)){
+                extractClocks[e].start();
+                traceBegin("extract batch", "extract", "seq", b->seq);
+                for (int i=0;i<b->count;i++){
+                    b->records.masks[i] = extractSkills(b->lines[i], scratch);
+                    std::string().swap(b->lines[i]);
+                }
+                extractClocks[e].stop();
+                traceEnd("extract batch", "extract");
+                extracted.push(b);
+            }
+            extracted.close();
+        });
+    }
+    
+    // Scorer: batches may arrive out of order, the writer restores it
+    std::thread scorer([&](){
+        traceThreadName("scorer");
+        BitMatrix resumeSkills;
+        StreamBatch* b;
+        while (extracted.pop(b)){
+            scoreClock.start();
+            traceBegin("score batch", "match", "seq", b->seq);
+            int capacity = b->records.count;
+            b->records.count = b->count;
+            MatchStats stats;
+            if (engine == ENGINE_TILED){
+                matchTiled(jobs, b->records, b->best, stats, false);
+            } else if (engine == ENGINE_BITMATRIX){
+                buildSkillMatrix(resumeSkills, b->records.masks, b->count, SKILL_COUNT);
+                matchBitMatrix(jobs, jobSkills, b->records, resumeSkills, b->best, stats, false);
+            } else {
+                matchDeduplicated(jobs, b->records, b->best, stats, false);
+            }
+            b->records.count = capacity;
+            scoreClock.stop();
+            traceEnd("score batch", "match");
+            scored.push(b);
+        }
+        scored.close();
+    });
+    
+    // Writer (this thread): append batches in file order. At most poolSize
+    // batches exist, so a batch's slot in the reorder window is seq % poolSize.
+    StreamBatch** pending = new StreamBatch*[poolSize];
+    for (int i=0;i<poolSize;i++) pending[i] = nullptr;
+    long long nextSeq = 0;
+    
+    StreamBatch* b;
+    while (scored.pop(b)){
+        pending[b->seq % poolSize] = b;
+        
+        while (pending[nextSeq % poolSize] != nullptr){
+            StreamBatch* w = pending[nextSeq % poolSize];
+            pending[nextSeq % poolSize] = nullptr;
+            
+            writeClock.start();
+            traceBegin("writer flush", "write", "seq", w->seq);
+            for (int i=0;i<w->count;i++){
+                csv << w->records.ids[i] << "," << w->best[i].jobId << ","
+                    << std::fixed << std::setprecision(2) << w->best[i].score << ","
+                    << w->best[i].matchedSkills << "\n";
+            }
+            writeClock.stop();
+            traceEnd("writer flush", "write");
+            
+            total += w->count;
+            batches++;
+            nextSeq++;
+            freeBatches.push(w);
+            
+            std::cout << "Batch " << batches << ": " << total << " resumes matched\r";
+            std::cout.flush();
+        }
     }
     
-    std::cout << "100% Done!\n";
+    reader.join();
+    for (int e=0;e<extractors;e++) extractThreads[e].join();
+    scorer.join();
+    csv.close();
+    
+    auto t2 = std::chrono::high_resolution_clock::now();
+    long long us = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count();
+    
+    long long extractUs = 0;
+    for (int e=0;e<extractors;e++) extractUs += extractClocks[e].busyUs;
+    
+    std::cout << "\nStreamed " << total << " resumes in " << batches << " batch(es)\n";
+    std::cout << "Stage busy time: read " << std::fixed << std::setprecision(2) << (readClock.busyUs/1000.0)
+              << " ms, extract " << (extractUs/1000.0)
+              << " ms, score " << (scoreClock.busyUs/1000.0)
+              << " ms, write " << (writeClock.busyUs/1000.0) << " ms\n";
+    std::cout << "Streaming time: " << (us/1000.0) << " ms wall ("
+              << ((readClock.busyUs + extractUs + scoreClock.busyUs + writeClock.busyUs)/1000.0)
+              << " ms if run in sequence)\n";
+    std::cout << "Results saved to: matches_array.csv\n";
+    
+    delete[] pending;
+    delete[] extractThreads;
+    delete[] extractClocks;
+    delete[] pool;
+}
+
+// workers > 1 runs the match in that many forked processes (see matchSharded)
+static void performFullMatching(const ArrayStore& store, int workers = 1){
+    const ResumeA* RESUMES = store.resumes;
+    int J = store.jobCount, R = store.resumeCount;
+    MemoryPhase memory;
+    CounterPhase counters;
+    TraceScope scope("full match", "match", "workers", workers);
+    auto t1 = std::chrono::high_resolution_clock::now();
+
+    MatchStats stats;
+    MatchEngine engine = g_engine;
+    bool sharded = false;
+    if (workers > 1){
+        if (engine == ENGINE_REFERENCE) engine = ENGINE_DEDUP;    // workers need compact records
+        CompactRecords jobs, resumes;
+        buildCompact(store, jobs, resumes);
+        sharded = matchSharded(engine, jobs, resumes, SKILL_COUNT, workers, BEST, stats);
+        if (!sharded){
+            std::cout << "Could not run worker processes, matching in this process.\n";
+            engine = g_engine;
+        }
+    }
+    if (!sharded) runEngine(store, engine, BEST, stats, true);
+    g_bestVersion = store.version;
 
     auto t2 = std::chrono::high_resolution_clock::now();
     g_match_us = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count();
+    g_matchMemory = memory.finish();
+    g_counters.phases[PHASE_MATCH] = counters.finish();
+    
+    std::cout << "Engine: " << engineName(engine);
+    if (sharded) std::cout << " in " << workers << " worker processes";
+    std::cout << "\n";
+    if (!sharded && engine == ENGINE_DEDUP){
+        std::cout << "Distinct profiles: " << stats.jobClasses << " jobs, "
+                  << stats.resumeClasses << " resumes (" << stats.pairsScored
+                  << " pairs scored instead of " << ((long long)J * R) << ")\n";
+    }
 
     // Write CSV
     std::ofstream csv("matches_array.csv");
@@ -345,8 +939,20 @@ static void performFullMatching(){
     csv.close();
 }
 
-// Sorting - Bubble Sort
+// Sorting - Bubble Sort (on a copy of the current data, which then replaces it).
+// The writer lock is held from the copy to the publish, so a reload that
+// finishes meanwhile is published after the sorted copy, never under it.
 static void sortJobsById(){
+    std::lock_guard<std::mutex> writer(g_writerLock);
+    ArrayStore* sorted;
+    {
+        RcuReadGuard guard(g_epochs);
+        sorted = copyStore(*g_store.read(guard));
+    }
+    JobA* JOBS = sorted->jobs;
+    int J = sorted->jobCount;
+    
+    CounterPhase counters;
     for (int i=0;i<J-1;i++)
         for (int k=i+1;k<J;k++)
             if (JOBS[k].id < JOBS[i].id){ 
@@ -354,9 +960,22 @@ static void sortJobsById(){
                 JOBS[i]=JOBS[k]; 
                 JOBS[k]=t; 
             }
+    g_counters.phases[PHASE_SORT] = counters.finish();
+    
+    publishStore(sorted);
 }
 
 static void sortResumesById(){
+    std::lock_guard<std::mutex> writer(g_writerLock);
+    ArrayStore* sorted;
+    {
+        RcuReadGuard guard(g_epochs);
+        sorted = copyStore(*g_store.read(guard));
+    }
+    ResumeA* RESUMES = sorted->resumes;
+    int R = sorted->resumeCount;
+    
+    CounterPhase counters;
     for (int i=0;i<R-1;i++)
         for (int k=i+1;k<R;k++)
             if (RESUMES[k].id < RESUMES[i].id){ 
@@ -364,31 +983,51 @@ static void sortResumesById(){
                 RESUMES[i]=RESUMES[k]; 
                 RESUMES[k]=t; 
             }
+    g_counters.phases[PHASE_SORT] = counters.finish();
+    
+    publishStore(sorted);
 }
 
 // Search - Linear Search
-static JobA* findJob(int id){    
-    for (int i=0;i<J;i++) 
-        if (JOBS[i].id==id) return &JOBS[i]; 
+static const JobA* findJob(const ArrayStore& store, int id){    
+    for (int i=0;i<store.jobCount;i++) 
+        if (store.jobs[i].id==id) return &store.jobs[i]; 
     return nullptr; 
 }
 
-static ResumeA* findResume(int id){ 
-    for (int i=0;i<R;i++) 
-        if (RESUMES[i].id==id) return &RESUMES[i]; 
+static const ResumeA* findResume(const ArrayStore& store, int id){ 
+    for (int i=0;i<store.resumeCount;i++) 
+        if (store.resumes[i].id==id) return &store.resumes[i]; 
     return nullptr; 
 }
 
 // Display functions
-static void displayAllJobs(){
-    for (int i=0;i<J;i++) JOBS[i].display();
+static void displayAllJobs(const ArrayStore& store){
+    for (int i=0;i<store.jobCount;i++) store.jobs[i].display();
 }
 
-static void displayAllResumes(){
-    for (int i=0;i<R;i++) RESUMES[i].display();
+static void displayAllResumes(const ArrayStore& store){
+    for (int i=0;i<store.resumeCount;i++) store.resumes[i].display();
 }
 
-static void displayTopMatches(int top){
+// BEST lines up with the resumes of one version only; a reload or a sort
+// publishes a new one and the positions no longer match
+static bool matchesAreCurrent(const ArrayStore& store){
+    if (g_bestVersion == store.version) return true;
+    if (g_bestVersion == 0){
+        std::cout << "No matches yet. Run the matching first (option 7).\n";
+    } else {
+        std::cout << "Matches were computed on data version " << g_bestVersion
+                  << ", but the current version is " << store.version
+                  << ".\nRun the matching again (option 7).\n";
+    }
+    return false;
+}
+
+static void displayTopMatches(const ArrayStore& store, int top){
+    const ResumeA* RESUMES = store.resumes;
+    int R = store.resumeCount;
+    if (!matchesAreCurrent(store)) return;
     if (R==0){ 
         std::cout << "No matches to display.\n"; 
         return; 
@@ -401,6 +1040,7 @@ static void displayTopMatches(int top){
         int k; 
     };
     
+    CounterPhase counters;
     Row* rows = new Row[R];
     for (int i=0;i<R;i++){
         rows[i] = { RESUMES[i].id, BEST[i].jobId, BEST[i].score, BEST[i].matchedSkills };
@@ -414,6 +1054,7 @@ static void displayTopMatches(int top){
                 rows[i]=rows[k]; 
                 rows[k]=t; 
             }
+    g_counters.phases[PHASE_TOPK] = counters.finish();
 
     int show = (top<R?top:R);
     std::cout << "\nTOP " << show << " MATCHES\n";
@@ -436,6 +1077,272 @@ static void displayTopMatches(int top){
     delete[] rows;
 }
 
+// Rest of the input line; the newline stays in the stream, as after >>
+static std::string readRestOfLine(){
+    std::string line;
+    while (std::cin.peek() != '\n' && std::cin.peek() != EOF) line += (char)std::cin.get();
+    return line;
+}
+
+static void runSkillQuery(const ArrayStore& store){
+    int side;
+    std::cout << "\nSearch (1) jobs or (2) resumes: ";
+    if (!(std::cin >> side) || (side != 1 && side != 2)){
+        std::cin.clear();
+        std::cout << "Invalid choice.\n";
+        return;
+    }
+    const SkillQueryIndex& index = side == 1 ? *store.jobSkills : *store.resumeSkills;
+    
+    std::cout << "Query (e.g. python AND sql AND NOT java): ";
+    std::cin >> std::ws;
+    std::string expression = readRestOfLine();
+    
+    CompressedBitmap result;
+    std::string error;
+    auto t0 = std::chrono::high_resolution_clock::now();
+    bool ok = index.evaluate(expression, result, error);
+    auto t1 = std::chrono::high_resolution_clock::now();
+    
+    if (!ok){
+        std::cout << "Invalid query: " << error << "\nKnown skills: ";
+        for (int s=0;s<index.skillCount();s++) std::cout << (s ? ", " : "") << index.skillName(s);
+        std::cout << "\n";
+        return;
+    }
+    
+    int total = result.cardinality();
+    std::cout << "\n" << total << " of " << index.recordCount()
+              << (side == 1 ? " jobs" : " resumes") << " match\n";
+    
+    const int SHOWN = 10;
+    int ids[SHOWN];
+    int shown = result.toArray(ids, SHOWN);
+    for (int i=0;i<shown;i++){
+        if (side == 1){
+            const JobA* j = findJob(store, ids[i]);
+            if (j) j->display();
+        } else {
+            const ResumeA* r = findResume(store, ids[i]);
+            if (r) r->display();
+        }
+    }
+    if (total > shown) std::cout << "... and " << (total - shown) << " more\n";
+    std::cout << "Query time: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count()
+              << " microseconds\n";
+}
+
+static void runKeywordSearch(const ArrayStore& store){
+    int side;
+    std::cout << "\nSearch (1) job descriptions or (2) resume summaries: ";
+    if (!(std::cin >> side) || (side != 1 && side != 2)){
+        std::cin.clear();
+        std::cout << "Invalid choice.\n";
+        return;
+    }
+    const WordIndex& words = side == 1 ? *store.jobWords : *store.resumeWords;
+    if (!words.isBuilt()) std::cout << "Indexing the " << (side == 1 ? "descriptions" : "summaries")
+                                    << " (first search since loading the snapshot)...\n";
+    const TextIndex& index = words.get();
+    
+    std::cout << "Keywords (all must appear): ";
+    std::cin >> std::ws;
+    std::string query = readRestOfLine();
+    
+    const int SHOWN = 10;
+    TextHit hits[SHOWN];
+    int matches = 0;
+    auto t0 = std::chrono::high_resolution_clock::now();
+    int shown = index.search(query, SHOWN, hits, matches);
+    auto t1 = std::chrono::high_resolution_clock::now();
+    
+    std::cout << "\n" << matches << " of " << index.documentCount()
+              << (side == 1 ? " jobs" : " resumes") << " contain every keyword\n";
+    for (int i=0;i<shown;i++){
+        std::cout << "  (" << hits[i].score << "x) ";
+        if (side == 1){
+            const JobA* j = findJob(store, hits[i].doc);
+            if (j) j->display();
+        } else {
+            const ResumeA* r = findResume(store, hits[i].doc);
+            if (r) r->display();
+        }
+    }
+    std::cout << "Query time: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count()
+              << " microseconds (" << index.wordCount() << " distinct words indexed)\n";
+}
+
+static void selectEngine(){
+    std::cout << "\nMatching engines:\n";
+    for (int e=0; e<ENGINE_COUNT; e++){
+        std::cout << "  " << (e+1) << ". " << engineName((MatchEngine)e)
+                  << (e == g_engine ? "  (current)" : "") << "\n";
+    }
+    std::cout << "Select engine: ";
+    int choice;
+    if (!(std::cin >> choice) || choice < 1 || choice > ENGINE_COUNT){
+        std::cin.clear();
+        std::cout << "Invalid engine, keeping " << engineName(g_engine) << ".\n";
+        return;
+    }
+    g_engine = (MatchEngine)(choice - 1);
+    std::cout << "Using " << engineName(g_engine) << ".\n";
+}
+
+static void selectScoreMode(){
+    std::cout << "\nScore modes:\n";
+    for (int m=0; m<SCORE_MODE_COUNT; m++){
+        std::cout << "  " << (m+1) << ". " << scoreModeName((ScoreMode)m)
+                  << (m == scoreMode() ? "  (current)" : "") << "\n";
+    }
+    std::cout << "Select score mode: ";
+    int choice;
+    if (!(std::cin >> choice) || choice < 1 || choice > SCORE_MODE_COUNT){
+        std::cin.clear();
+        std::cout << "Invalid score mode, keeping " << scoreModeName(scoreMode()) << ".\n";
+        return;
+    }
+    setScoreMode((ScoreMode)(choice - 1));
+    std::cout << "Using " << scoreModeName(scoreMode()) << " scores.\n";
+}
+
+// Time every engine on the loaded data and check it against the reference
+static void benchmarkEngines(const ArrayStore& store){
+    int J = store.jobCount, R = store.resumeCount;
+    if (R==0 || J==0){
+        std::cout << "No data loaded.\n";
+        return;
+    }
+    
+    BestMatch* expected = new BestMatch[R];
+    BestMatch* got = new BestMatch[R];
+    long long referenceUs = 0;
+    CounterSample hw[ENGINE_COUNT];
+    
+    std::cout << "\nBenchmarking " << ENGINE_COUNT << " engines on " << R
+              << " resumes x " << J << " jobs...\n";
+    std::cout << "-------------------------------------------------------------------\n";
+    std::cout << std::left << std::setw(26) << "Engine"
+              << " | " << std::setw(10) << "Time (ms)"
+              << " | " << std::setw(12) << "Pairs"
+              << " | " << std::setw(7) << "Speedup"
+              << " | " << "Result\n";
+    std::cout << "-------------------------------------------------------------------\n";
+    
+    for (int e=0; e<ENGINE_COUNT; e++){
+        MatchStats stats;
+        BestMatch* out = (e == ENGINE_REFERENCE) ? expected : got;
+        
+        CounterPhase counters;
+        auto t1 = std::chrono::high_resolution_clock::now();
+        runEngine(store, (MatchEngine)e, out, stats, false);
+        auto t2 = std::chrono::high_resolution_clock::now();
+        hw[e] = counters.finish();
+        long long us = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count();
+        if (e == ENGINE_REFERENCE) referenceUs = us;
+        
+        bool same = true;
+        for (int i=0; i<R && same; i++){
+            same = out[i].jobId == expected[i].jobId && out[i].score == expected[i].score &&
+                   out[i].matchedSkills == expected[i].matchedSkills;
+        }
+        
+        std::cout << std::left << std::setw(26) << engineName((MatchEngine)e)
+                  << " | " << std::setw(10) << std::fixed << std::setprecision(2) << (us/1000.0)
+                  << " | " << std::setw(12) << stats.pairsScored
+                  << " | " << std::setw(7) << std::setprecision(1)
+                  << (us > 0 ? (double)referenceUs / us : 0.0)
+                  << " | " << (same ? "identical" : "MISMATCH") << "\n";
+    }
+    std::cout << "-------------------------------------------------------------------\n";
+    
+    if (hw[0].available()){
+        std::cout << "\nHardware counters\n";
+        std::cout << std::left << std::setw(26) << "Engine" << " | " << std::setw(8) << "Cycles"
+                  << " | " << std::setw(5) << "IPC";
+        for (int c = HW_L1D_MISSES; c < HW_COUNTER_COUNT; c++)
+            std::cout << " | " << std::setw(13) << hwCounterName(c);
+        std::cout << "\n";
+        for (int e=0; e<ENGINE_COUNT; e++){
+            double ipc = hw[e].ipc();
+            std::cout << std::left << std::setw(26) << engineName((MatchEngine)e)
+                      << " | " << std::setw(8) << formatCount(hw[e].values[HW_CYCLES])
+                      << " | " << std::setw(5);
+            if (ipc >= 0) std::cout << std::fixed << std::setprecision(2) << ipc;
+            else std::cout << "n/a";
+            for (int c = HW_L1D_MISSES; c < HW_COUNTER_COUNT; c++)
+                std::cout << " | " << std::setw(13) << formatCount(hw[e].values[c]);
+            std::cout << "\n";
+        }
+    } else {
+        std::cout << "Hardware counters not available (" << hwCountersStatus() << ")\n";
+    }
+    
+    delete[] expected;
+    delete[] got;
+}
+
+static const char* g_jobsPath = "";
+static const char* g_resumesPath = "";
+
+// Background reload: the new version is loaded on its own thread while the
+// menu keeps serving the current one, then swapped in
+static std::thread g_reloadThread;
+static std::atomic<bool> g_reloadRunning(false);
+
+static void startReload(long long currentVersion){
+    if (g_reloadRunning.load()){
+        std::cout << "A reload is already running.\n";
+        return;
+    }
+    if (g_reloadThread.joinable()) g_reloadThread.join();
+    
+    g_reloadRunning.store(true);
+    g_reloadThread = std::thread([](){
+        std::ostream quiet(nullptr);        // don't interleave with the menu
+        ArrayStore* loaded = loadStore(g_jobsPath, g_resumesPath, quiet);
+        std::lock_guard<std::mutex> writer(g_writerLock);
+        publishStore(loaded);
+        g_reloadRunning.store(false);
+    });
+    std::cout << "Reloading " << g_jobsPath << " and " << g_resumesPath
+              << " in the background.\nQueries use version " << currentVersion
+              << " until the new data is ready.\n";
+}
+
+static void finishReload(){
+    if (g_reloadThread.joinable()) g_reloadThread.join();
+}
+
+static void streamingMenu(const ArrayStore& store){
+    double mb;
+    std::cout << "Memory budget for matching (MB): ";
+    if (!(std::cin >> mb) || mb <= 0){
+        std::cin.clear();
+        std::cout << "Invalid budget.\n";
+        return;
+    }
+    std::cout << "\nStreaming resumes from " << g_resumesPath << "...\n";
+    performStreamingMatching(store, g_resumesPath, (long long)(mb * 1024 * 1024));
+}
+
+static void serveQueries(){
+    std::string path;
+    std::cout << "Socket path (e.g. jobmatch.sock): ";
+    std::cin >> path;
+    {
+        RcuReadGuard guard(g_epochs);
+        const ArrayStore* store = g_store.read(guard);
+        std::cout << "Version " << store->version << ": " << store->jobCount << " jobs, "
+                  << store->resumeCount << " resumes\n";
+    }
+    
+    QueryServerOptions options;
+    runQueryServer(path.c_str(), g_epochs, g_compact, options);
+}
+
 static void menu(){
     std::cout << "\n===============================================\n";
     std::cout << "            ARRAY IMPLEMENTATION MENU\n";
@@ -449,16 +1356,29 @@ static void menu(){
     std::cout << "  7. Perform Complete Job Matching\n";
     std::cout << "  8. Display Top Matches\n";
     std::cout << "  9. Display Performance Metrics\n";
+    std::cout << " 10. Select Matching Engine\n";
+    std::cout << " 11. Benchmark Matching Engines\n";
+    std::cout << " 12. Streaming Match (resumes read from disk)\n";
+    std::cout << " 13. Sharded Match (worker processes)\n";
+    std::cout << " 14. Reload Data (background)\n";
+    std::cout << " 15. Start Query Server (local socket)\n";
+    std::cout << " 16. Select Score Mode (floating / fixed point)\n";
+    std::cout << " 17. Boolean Skill Query (AND / OR / NOT)\n";
+    std::cout << " 18. Keyword Search (descriptions / summaries)\n";
     std::cout << "  0. Return to Main Menu\n";
     std::cout << "===============================================\n";
 }
 
-static void showPerf(){
+static void showPerf(const ArrayStore& store){
+    int J = store.jobCount, R = store.resumeCount;
     std::cout << "\nPerformance Summary (Array)\n";
     std::cout << "-----------------------------------------------\n";
     std::cout << "Records: Jobs=" << J << ", Resumes=" << R << "\n";
+    std::cout << "Data Version     : " << store.version << "\n";
     std::cout << "CSV Loading Time : " << g_load_us  << " us (" 
               << std::fixed << std::setprecision(2) << (g_load_us/1000.0) << " ms)\n";
+    std::cout << "Matching Engine  : " << engineName(g_engine) << "\n";
+    std::cout << "Score Mode       : " << scoreModeName(scoreMode()) << "\n";
     std::cout << "Matching Time    : " << g_match_us << " us (" 
               << std::fixed << std::setprecision(2) << (g_match_us/1000.0) << " ms)\n";
     std::cout << "Total Operations : " << (J * R) << " comparisons\n";
@@ -487,21 +1407,34 @@ ArrayPerf runArrayImplementation(const char* jobsCsvPath, const char* resumesCsv
     cout << "   ARRAY-BASED JOB MATCHING SYSTEM   \n";
     cout << "=====================================\n\n";
 
+    g_jobsPath = jobsCsvPath;
+    g_resumesPath = resumesCsvPath;
+    
     auto t0 = high_resolution_clock::now();
-    loadJobs(jobsCsvPath);
-    loadResumes(resumesCsvPath);
+    LoadReport report;
+    publishStore(loadStore(jobsCsvPath, resumesCsvPath, cout, &report));
     auto t1 = high_resolution_clock::now();
 
     g_load_us = duration_cast<microseconds>(t1 - t0).count();
+    g_jobsMemory = report.jobsMemory;
+    g_resumesMemory = report.resumesMemory;
+    g_counters.phases[PHASE_LOAD] = report.read;
+    g_counters.phases[PHASE_EXTRACT] = report.extract;
 
-    cout << "\nTotal Jobs Loaded    : " << J << "\n";
-    cout << "Total Resumes Loaded : " << R << "\n";
+    {
+        RcuReadGuard guard(g_epochs);
+        const ArrayStore* loaded = g_store.read(guard);
+        cout << "\nTotal Jobs Loaded    : " << loaded->jobCount << "\n";
+        cout << "Total Resumes Loaded : " << loaded->resumeCount << "\n";
+    }
     cout << "Load Time: " << fixed << setprecision(2) << (g_load_us/1000.0) << " ms\n";
 
     int choice; 
     bool running=true;
     
     while (running){
+        g_epochs.reclaim();     // free versions replaced since the last command
+        
         menu();
         cout << "Enter your choice: ";
         if (!(cin >> choice)) { 
@@ -510,25 +1443,42 @@ ArrayPerf runArrayImplementation(const char* jobsCsvPath, const char* resumesCsv
             continue; 
         }
         
+        // The query server reads the current version batch by batch; it must
+        // not run inside a command's read section, which would keep every
+        // version replaced meanwhile from being freed
+        if (choice == 15){
+            serveQueries();
+            cout << "\nPress Enter to continue...";
+            cin.ignore();
+            cin.get();
+            continue;
+        }
+        
+        // Each command works on the version current when it starts
+        RcuReadGuard guard(g_epochs);
+        const ArrayStore& store = *g_store.read(guard);
+        const ResumeA* RESUMES = store.resumes;
+        int J = store.jobCount, R = store.resumeCount;
+        
         switch (choice){
             case 1: 
                 cout << "\nDisplaying all jobs...\n"; 
-                displayAllJobs(); 
+                displayAllJobs(store); 
                 break;
                 
             case 2: 
                 cout << "\nDisplaying all resumes...\n"; 
-                displayAllResumes(); 
+                displayAllResumes(store); 
                 break;
                 
             case 3: {
                 int id; 
                 cout << "Enter Job ID: "; 
                 cin >> id;
-                JobA* j = findJob(id);
+                const JobA* j = findJob(store, id);
                 if (j){ 
                     cout << "\nJob found:\n"; 
-                    j->displayDetailed(); 
+                    j->displayDetailed(*store.jobText); 
                 } else {
                     cout << "Job not found.\n";
                 }
@@ -539,10 +1489,10 @@ ArrayPerf runArrayImplementation(const char* jobsCsvPath, const char* resumesCsv
                 int id; 
                 cout << "Enter Resume ID: "; 
                 cin >> id;
-                ResumeA* r = findResume(id);
+                const ResumeA* r = findResume(store, id);
                 if (r){ 
                     cout << "\nResume found:\n"; 
-                    r->displayDetailed(); 
+                    r->displayDetailed(*store.resumeText); 
                 } else {
                     cout << "Resume not found.\n";
                 }
@@ -564,7 +1514,8 @@ ArrayPerf runArrayImplementation(const char* jobsCsvPath, const char* resumesCsv
             case 7: {
                 cout << "\nPerforming job matching analysis...\n";
                 cout << "This will compare " << R << " resumes with " << J << " jobs...\n";
-                performFullMatching();
+                performFullMatching(store);
+                if (!matchesAreCurrent(store)) break;
                 
                 cout << "\n--------------------------------------------\n";
                 cout << left << setw(10) << "Resume ID"
@@ -596,12 +1547,57 @@ ArrayPerf runArrayImplementation(const char* jobsCsvPath, const char* resumesCsv
                 int top; 
                 cout << "Show top how many matches? "; 
                 cin >> top;
-                displayTopMatches(top);
+                displayTopMatches(store, top);
                 break;
             }
             
             case 9: 
-                showPerf(); 
+                showPerf(store); 
+                break;
+                
+            case 10:
+                selectEngine();
+                break;
+                
+            case 11:
+                benchmarkEngines(store);
+                break;
+                
+            case 12:
+                streamingMenu(store);
+                break;
+                
+            case 13: {
+                int workers;
+                cout << "Number of worker processes: ";
+                if (!(cin >> workers) || workers < 1){
+                    cin.clear();
+                    cout << "Invalid number.\n";
+                    break;
+                }
+                cout << "\nMatching " << R << " resumes against " << J << " jobs split over "
+                     << workers << " workers...\n";
+                performFullMatching(store, workers);
+                cout << "Matching time: " << fixed << setprecision(2)
+                     << (g_match_us/1000.0) << " ms\n";
+                cout << "Results saved to: matches_array.csv\n";
+                break;
+            }
+            
+            case 14:
+                startReload(store.version);
+                break;
+                
+            case 16:
+                selectScoreMode();
+                break;
+                
+            case 17:
+                runSkillQuery(store);
+                break;
+                
+            case 18:
+                runKeywordSearch(store);
                 break;
                 
             case 0:  
@@ -619,10 +1615,19 @@ ArrayPerf runArrayImplementation(const char* jobsCsvPath, const char* resumesCsv
         }
     }
 
+    finishReload();
+    
+    RcuReadGuard guard(g_epochs);
+    const ArrayStore* store = g_store.read(guard);
+    
     ArrayPerf out;
     out.load_us  = g_load_us;
     out.match_us = g_match_us;
-    out.jobs     = J;
-    out.resumes  = R;
+    out.jobs     = store->jobCount;
+    out.resumes  = store->resumeCount;
+    out.jobsMemory    = g_jobsMemory;
+    out.resumesMemory = g_resumesMemory;
+    out.matchMemory   = g_matchMemory;
+    out.counters      = g_counters;
     return out;
 }
\ No newline at end of file
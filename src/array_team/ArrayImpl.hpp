@@ -1,12 +1,19 @@
 #ifndef ARRAYIMPL_HPP
 #define ARRAYIMPL_HPP
 
+#include "../shared/AllocTracker.hpp"
+#include "../shared/PerfCounters.hpp"
+
 // Performance tracking structure for array implementation
 struct ArrayPerf {
     long long load_us;    // CSV loading time in microseconds
     long long match_us;   // Matching algorithm time in microseconds
     int jobs;             // Number of jobs loaded
     int resumes;          // Number of resumes loaded
+    PhaseMemory jobsMemory;     // Loading the job array
+    PhaseMemory resumesMemory;  // Loading the resume array
+    PhaseMemory matchMemory;    // Last complete matching run
+    PhaseCounters counters;     // Hardware counters per phase (see PerfCounters.hpp)
     
     // Constructor to initialize values
     ArrayPerf() : load_us(0), match_us(0), jobs(0), resumes(0) {}
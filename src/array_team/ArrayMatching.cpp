@@ -0,0 +1,859 @@
+// ArrayMatching.cpp - Matching kernels over compact records
+
+#include "ArrayMatching.hpp"
+#include "../shared/Tracer.hpp"
+#include <iostream>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace arr {
+
+const ScoreTables<ArrayScoringPolicy> SCORE_TABLES;
+const FixedScoreTables<ArrayScoringPolicy> FIXED_SCORE_TABLES;
+
+// Linked list scoring, for top-k queries that must agree with that engine
+static const ScoreTables<LinkedListScoringPolicy> LINKED_LIST_SCORE_TABLES;
+static const FixedScoreTables<LinkedListScoringPolicy> LINKED_LIST_FIXED_SCORE_TABLES;
+
+struct LinkedListFloatingScores {
+    typedef double Value;
+    static inline Value none() { return -1.0; }
+    static inline Value score(int overlap, int jobSkills, int resumeSkills, int required, int actual) {
+        return LINKED_LIST_SCORE_TABLES.score(overlap, jobSkills, resumeSkills, required, actual);
+    }
+    static inline double toDouble(Value v) { return v < 0 ? 0.0 : v; }
+};
+
+struct LinkedListFixedScores {
+    typedef short Value;
+    static inline Value none() { return -1; }
+    static inline Value score(int overlap, int jobSkills, int resumeSkills, int required, int actual) {
+        return LINKED_LIST_FIXED_SCORE_TABLES.score(overlap, jobSkills, resumeSkills, required, actual);
+    }
+    static inline double toDouble(Value v) { return v < 0 ? 0.0 : v / 100.0; }
+};
+
+// Set from the menu between runs; forked shard workers inherit it
+static ScoreMode g_scoreMode = SCORE_FLOATING;
+
+const char* scoreModeName(ScoreMode mode) {
+    switch (mode) {
+        case SCORE_FLOATING: return "Floating point";
+        case SCORE_FIXED:    return "Fixed point (hundredths)";
+        default:             return "Unknown";
+    }
+}
+
+ScoreMode scoreMode() { return g_scoreMode; }
+
+void setScoreMode(ScoreMode mode) { g_scoreMode = mode; }
+
+// CompactRecords
+CompactRecords::CompactRecords() : count(0), ids(nullptr), years(nullptr), masks(nullptr) {}
+
+CompactRecords::~CompactRecords() {
+    delete[] ids;
+    delete[] years;
+    delete[] masks;
+}
+
+void CompactRecords::resize(int n) {
+    delete[] ids;
+    delete[] years;
+    delete[] masks;
+    count = n;
+    ids = new int[n > 0 ? n : 1];
+    years = new int[n > 0 ? n : 1];
+    masks = new unsigned long long[n > 0 ? n : 1];
+}
+
+// BitMatrix
+BitMatrix::BitMatrix() : rows(0), cols(0), words(0), bits(nullptr), rowCounts(nullptr) {}
+
+BitMatrix::~BitMatrix() {
+    delete[] bits;
+    delete[] rowCounts;
+}
+
+void BitMatrix::resize(int r, int c) {
+    delete[] bits;
+    delete[] rowCounts;
+    rows = r;
+    cols = c;
+    words = (c + 63) / 64;
+    if (words == 0) words = 1;
+    long long total = (long long)rows * words;
+    bits = new unsigned long long[total > 0 ? total : 1];
+    for (long long i = 0; i < total; i++) bits[i] = 0;
+    rowCounts = new int[rows > 0 ? rows : 1];
+    for (int i = 0; i < rows; i++) rowCounts[i] = 0;
+}
+
+void BitMatrix::set(int r, int c) {
+    bits[(long long)r * words + c / 64] |= 1ULL << (c % 64);
+}
+
+void BitMatrix::finish() {
+    for (int r = 0; r < rows; r++) {
+        const unsigned long long* p = row(r);
+        int count = 0;
+        for (int w = 0; w < words; w++) count += popcount64(p[w]);
+        rowCounts[r] = count;
+    }
+}
+
+void buildSkillMatrix(BitMatrix& m, const unsigned long long* masks, int count, int vocabularySize) {
+    m.resize(count, vocabularySize);
+    for (int i = 0; i < count; i++) {
+        for (int k = 0; k < vocabularySize; k++) {
+            if (masks[i] & (1ULL << k)) m.set(i, k);
+        }
+    }
+    m.finish();
+}
+
+// PositionIndex
+PositionIndex::PositionIndex() : firstId(0), span(0), positions(nullptr) {}
+
+PositionIndex::~PositionIndex() {
+    delete[] positions;
+}
+
+void PositionIndex::build(const CompactRecords& records) {
+    delete[] positions;
+    int lo = 0, hi = -1;
+    for (int i = 0; i < records.count; i++) {
+        if (i == 0 || records.ids[i] < lo) lo = records.ids[i];
+        if (i == 0 || records.ids[i] > hi) hi = records.ids[i];
+    }
+    firstId = lo;
+    span = hi - lo + 1;
+    positions = new int[span > 0 ? span : 1];
+    for (int i = 0; i < span; i++) positions[i] = -1;
+    for (int i = 0; i < records.count; i++) positions[records.ids[i] - lo] = i;
+}
+
+const char* engineName(MatchEngine engine) {
+    switch (engine) {
+        case ENGINE_REFERENCE: return "Reference (pair by pair)";
+        case ENGINE_DEDUP:     return "Deduplicated profiles";
+        case ENGINE_TILED:     return "Tiled all-pairs";
+        case ENGINE_BITMATRIX: return "Bit-matrix product";
+        default:               return "Unknown";
+    }
+}
+
+// Compact record: id + years + mask
+static const long long COMPACT_BYTES = 2 * sizeof(int) + sizeof(unsigned long long);
+
+// ProfileClasses (below): class per record, first member, mask and years per
+// class, and a hash table of up to 4 slots per record
+static const long long CLASS_BYTES = 3 * sizeof(int) + sizeof(unsigned long long) + 4 * sizeof(int);
+
+long long engineBytesPerJob(MatchEngine engine) {
+    switch (engine) {
+        case ENGINE_DEDUP:     return COMPACT_BYTES + CLASS_BYTES;
+        case ENGINE_TILED:     return COMPACT_BYTES + sizeof(int);
+        case ENGINE_BITMATRIX: return COMPACT_BYTES + sizeof(int) + sizeof(unsigned long long);
+        default:               return COMPACT_BYTES;
+    }
+}
+
+long long engineBytesPerResume(MatchEngine engine, int vocabularySize) {
+    long long words = (vocabularySize + 63) / 64;
+    if (words == 0) words = 1;
+    switch (engine) {
+        case ENGINE_DEDUP:     return COMPACT_BYTES + sizeof(BestMatch) * 2 + CLASS_BYTES;
+        case ENGINE_BITMATRIX: return COMPACT_BYTES + sizeof(BestMatch) + sizeof(int) +
+                                      words * sizeof(unsigned long long);
+        default:               return COMPACT_BYTES + sizeof(BestMatch);
+    }
+}
+
+// "Matching progress: 0% 10% ... 100% Done!" in 10% steps
+struct Progress {
+    int total;
+    int nextMark;
+    bool enabled;
+    
+    Progress(int total, bool enabled) : total(total > 0 ? total : 1), nextMark(0), enabled(enabled) {
+        if (enabled) std::cout << "Matching progress: ";
+    }
+    
+    void update(int done) {
+        if (!enabled) return;
+        while (done * 100LL / total >= nextMark && nextMark < 100) {
+            std::cout << nextMark << "% ";
+            nextMark += 10;
+        }
+        std::cout.flush();
+    }
+    
+    void finish() {
+        if (enabled) std::cout << "100% Done!\n";
+    }
+};
+
+// Groups records with identical (skill mask, years) into classes.
+// Classes are numbered in order of first appearance, so class c's first
+// member comes before class c+1's first member.
+struct ProfileClasses {
+    int count = 0;
+    int* classOf = nullptr;          // per record
+    int* firstMember = nullptr;      // per class
+    unsigned long long* masks = nullptr;
+    int* years = nullptr;
+    
+    ~ProfileClasses() {
+        delete[] classOf;
+        delete[] firstMember;
+        delete[] masks;
+        delete[] years;
+    }
+    
+    void build(const CompactRecords& recs) {
+        int n = recs.count;
+        int cap = n > 0 ? n : 1;
+        classOf = new int[cap];
+        firstMember = new int[cap];
+        masks = new unsigned long long[cap];
+        years = new int[cap];
+        count = 0;
+        
+        // Open addressing table of class ids, load factor <= 1/2
+        int tableSize = 2;
+        while (tableSize < 2 * n) tableSize *= 2;
+        int* table = new int[tableSize];
+        for (int i = 0; i < tableSize; i++) table[i] = -1;
+        
+        for (int r = 0; r < n; r++) {
+            unsigned long long key = recs.masks[r] ^ ((unsigned long long)(unsigned int)recs.years[r] * 0x9E3779B97F4A7C15ULL);
+            key ^= key >> 29;
+            key *= 0xBF58476D1CE4E5B9ULL;
+            key ^= key >> 32;
+            
+            int pos = (int)(key & (unsigned long long)(tableSize - 1));
+            while (table[pos] != -1) {
+                int c = table[pos];
+                if (masks[c] == recs.masks[r] && years[c] == recs.years[r]) break;
+                pos = (pos + 1) & (tableSize - 1);
+            }
+            
+            if (table[pos] == -1) {
+                table[pos] = count;
+                masks[count] = recs.masks[r];
+                years[count] = recs.years[r];
+                firstMember[count] = r;
+                count++;
+            }
+            classOf[r] = table[pos];
+        }
+        delete[] table;
+    }
+};
+
+template <typename Scores>
+static void dedupKernel(const CompactRecords& jobs, const CompactRecords& resumes,
+                        BestMatch* best, MatchStats& stats, bool showProgress) {
+    typedef typename Scores::Value Score;
+    ProfileClasses jobClasses, resumeClasses;
+    traceBegin("classify profiles", "match");
+    jobClasses.build(jobs);
+    resumeClasses.build(resumes);
+    traceEnd("classify profiles", "match");
+    
+    stats.jobClasses = jobClasses.count;
+    stats.resumeClasses = resumeClasses.count;
+    stats.pairsScored = (long long)jobClasses.count * resumeClasses.count;
+    
+    BestMatch* classBest = new BestMatch[resumeClasses.count > 0 ? resumeClasses.count : 1];
+    
+    Progress progress(resumeClasses.count, showProgress);
+    TraceScope scope("score classes", "match", "pairs", stats.pairsScored);
+    
+    for (int rc = 0; rc < resumeClasses.count; rc++) {
+        progress.update(rc);
+        
+        unsigned long long resMask = resumeClasses.masks[rc];
+        int resYears = resumeClasses.years[rc];
+        
+        // Classes are visited in order of their first member, so a strict
+        // comparison keeps the earliest job among equal scores
+        Score bestS = Scores::none();
+        int bestC = -1;
+        for (int jc = 0; jc < jobClasses.count; jc++) {
+            Score s = compactScore<Scores>(jobClasses.masks[jc], jobClasses.years[jc], resMask, resYears);
+            if (s > bestS) {
+                bestS = s;
+                bestC = jc;
+            }
+        }
+        
+        if (bestC >= 0) {
+            classBest[rc].jobId = jobs.ids[jobClasses.firstMember[bestC]];
+            classBest[rc].score = Scores::toDouble(bestS);
+            classBest[rc].matchedSkills = popcount64(jobClasses.masks[bestC] & resMask);
+        }
+    }
+    
+    // Expand class results back to individual resumes
+    for (int r = 0; r < resumes.count; r++) {
+        best[r] = classBest[resumeClasses.classOf[r]];
+    }
+    delete[] classBest;
+    
+    progress.finish();
+}
+
+void matchDeduplicated(const CompactRecords& jobs, const CompactRecords& resumes,
+                       BestMatch* best, MatchStats& stats, bool showProgress) {
+    if (g_scoreMode == SCORE_FIXED) dedupKernel<FixedScores>(jobs, resumes, best, stats, showProgress);
+    else dedupKernel<FloatingScores>(jobs, resumes, best, stats, showProgress);
+}
+
+// Tile sizes: a job tile (8 + 4 + 4 bytes per job) fits in L1 next to the
+// score tables, and a resume block's running bests stay in L2
+static const int JOB_TILE = 1024;
+static const int RESUME_BLOCK = 256;
+static const int RESUMES_PER_PASS = 4;    // register blocking
+
+template <typename Scores>
+static void tiledKernel(const CompactRecords& jobs, const CompactRecords& resumes,
+                        BestMatch* best, MatchStats& stats, bool showProgress) {
+    typedef typename Scores::Value Score;
+    int J = jobs.count;
+    int R = resumes.count;
+    stats.jobClasses = 0;
+    stats.resumeClasses = 0;
+    stats.pairsScored = (long long)J * R;
+    
+    // Skill counts are needed for every pair, compute them once
+    int* jobSkills = new int[J > 0 ? J : 1];
+    for (int j = 0; j < J; j++) jobSkills[j] = popcount64(jobs.masks[j]);
+    
+    Score* bestScore = new Score[RESUME_BLOCK];
+    int* bestJob = new int[RESUME_BLOCK];
+    
+    Progress progress(R, showProgress);
+    
+    for (int r0 = 0; r0 < R; r0 += RESUME_BLOCK) {
+        int r1 = (r0 + RESUME_BLOCK < R) ? r0 + RESUME_BLOCK : R;
+        progress.update(r0);
+        
+        for (int r = r0; r < r1; r++) {
+            bestScore[r - r0] = Scores::none();
+            bestJob[r - r0] = -1;
+        }
+        
+        // Job tiles are visited in order and each comparison is strict, so
+        // the first job with the best score wins, as in the reference loop
+        for (int j0 = 0; j0 < J; j0 += JOB_TILE) {
+            int j1 = (j0 + JOB_TILE < J) ? j0 + JOB_TILE : J;
+            TraceScope tile("tile", "match", "resume", r0);
+            
+            int r = r0;
+            for (; r + RESUMES_PER_PASS <= r1; r += RESUMES_PER_PASS) {
+                unsigned long long m0 = resumes.masks[r],     m1 = resumes.masks[r + 1];
+                unsigned long long m2 = resumes.masks[r + 2], m3 = resumes.masks[r + 3];
+                int y0 = resumes.years[r],     y1 = resumes.years[r + 1];
+                int y2 = resumes.years[r + 2], y3 = resumes.years[r + 3];
+                int n0 = popcount64(m0), n1 = popcount64(m1);
+                int n2 = popcount64(m2), n3 = popcount64(m3);
+                
+                Score s0 = bestScore[r - r0],     s1 = bestScore[r - r0 + 1];
+                Score s2 = bestScore[r - r0 + 2], s3 = bestScore[r - r0 + 3];
+                int b0 = bestJob[r - r0],     b1 = bestJob[r - r0 + 1];
+                int b2 = bestJob[r - r0 + 2], b3 = bestJob[r - r0 + 3];
+                
+                for (int j = j0; j < j1; j++) {
+                    unsigned long long jm = jobs.masks[j];
+                    int jn = jobSkills[j];
+                    int jy = jobs.years[j];
+                    
+                    Score s;
+                    s = Scores::score(popcount64(jm & m0), jn, n0, jy, y0);
+                    if (s > s0) { s0 = s; b0 = j; }
+                    s = Scores::score(popcount64(jm & m1), jn, n1, jy, y1);
+                    if (s > s1) { s1 = s; b1 = j; }
+                    s = Scores::score(popcount64(jm & m2), jn, n2, jy, y2);
+                    if (s > s2) { s2 = s; b2 = j; }
+                    s = Scores::score(popcount64(jm & m3), jn, n3, jy, y3);
+                    if (s > s3) { s3 = s; b3 = j; }
+                }
+                
+                bestScore[r - r0] = s0;     bestJob[r - r0] = b0;
+                bestScore[r - r0 + 1] = s1; bestJob[r - r0 + 1] = b1;
+                bestScore[r - r0 + 2] = s2; bestJob[r - r0 + 2] = b2;
+                bestScore[r - r0 + 3] = s3; bestJob[r - r0 + 3] = b3;
+            }
+            
+            // Leftover resumes of the block, one at a time
+            for (; r < r1; r++) {
+                unsigned long long m = resumes.masks[r];
+                int y = resumes.years[r];
+                int n = popcount64(m);
+                Score sBest = bestScore[r - r0];
+                int bBest = bestJob[r - r0];
+                
+                for (int j = j0; j < j1; j++) {
+                    Score s = Scores::score(popcount64(jobs.masks[j] & m),
+                                            jobSkills[j], n, jobs.years[j], y);
+                    if (s > sBest) { sBest = s; bBest = j; }
+                }
+                bestScore[r - r0] = sBest;
+                bestJob[r - r0] = bBest;
+            }
+        }
+        
+        for (int r = r0; r < r1; r++) {
+            int j = bestJob[r - r0];
+            best[r].jobId = (j >= 0) ? jobs.ids[j] : -1;
+            best[r].score = Scores::toDouble(bestScore[r - r0]);
+            best[r].matchedSkills = (j >= 0) ? popcount64(jobs.masks[j] & resumes.masks[r]) : 0;
+        }
+    }
+    
+    delete[] jobSkills;
+    delete[] bestScore;
+    delete[] bestJob;
+    
+    progress.finish();
+}
+
+void matchTiled(const CompactRecords& jobs, const CompactRecords& resumes,
+                BestMatch* best, MatchStats& stats, bool showProgress) {
+    if (g_scoreMode == SCORE_FIXED) tiledKernel<FixedScores>(jobs, resumes, best, stats, showProgress);
+    else tiledKernel<FloatingScores>(jobs, resumes, best, stats, showProgress);
+}
+
+// Block sizes for the product: a job block's rows stay in L1 while a
+// resume block's rows and the overlap block sit in L2
+static const int GEMM_JOB_BLOCK = 128;
+static const int GEMM_RESUME_BLOCK = 128;
+
+// Overlap block C[j][r] = popcount(A_j & B_r) over all words, with a 2x4
+// micro-kernel (two job rows, four resume rows per step)
+static void overlapBlock(const BitMatrix& A, int j0, int j1,
+                         const BitMatrix& B, int r0, int r1,
+                         unsigned short* C) {
+    int words = A.words;
+    int j = j0;
+    for (; j + 2 <= j1; j += 2) {
+        const unsigned long long* a0 = A.row(j);
+        const unsigned long long* a1 = A.row(j + 1);
+        unsigned short* c0 = C + (j - j0) * GEMM_RESUME_BLOCK;
+        unsigned short* c1 = c0 + GEMM_RESUME_BLOCK;
+        
+        int r = r0;
+        for (; r + 4 <= r1; r += 4) {
+            const unsigned long long* b0 = B.row(r);
+            const unsigned long long* b1 = B.row(r + 1);
+            const unsigned long long* b2 = B.row(r + 2);
+            const unsigned long long* b3 = B.row(r + 3);
+            int x00 = 0, x01 = 0, x02 = 0, x03 = 0;
+            int x10 = 0, x11 = 0, x12 = 0, x13 = 0;
+            for (int w = 0; w < words; w++) {
+                unsigned long long p = a0[w], q = a1[w];
+                x00 += popcount64(p & b0[w]); x01 += popcount64(p & b1[w]);
+                x02 += popcount64(p & b2[w]); x03 += popcount64(p & b3[w]);
+                x10 += popcount64(q & b0[w]); x11 += popcount64(q & b1[w]);
+                x12 += popcount64(q & b2[w]); x13 += popcount64(q & b3[w]);
+            }
+            int c = r - r0;
+            c0[c] = (unsigned short)x00; c0[c + 1] = (unsigned short)x01;
+            c0[c + 2] = (unsigned short)x02; c0[c + 3] = (unsigned short)x03;
+            c1[c] = (unsigned short)x10; c1[c + 1] = (unsigned short)x11;
+            c1[c + 2] = (unsigned short)x12; c1[c + 3] = (unsigned short)x13;
+        }
+        for (; r < r1; r++) {
+            const unsigned long long* b = B.row(r);
+            int x0 = 0, x1 = 0;
+            for (int w = 0; w < words; w++) {
+                x0 += popcount64(a0[w] & b[w]);
+                x1 += popcount64(a1[w] & b[w]);
+            }
+            c0[r - r0] = (unsigned short)x0;
+            c1[r - r0] = (unsigned short)x1;
+        }
+    }
+    for (; j < j1; j++) {
+        const unsigned long long* a = A.row(j);
+        unsigned short* c = C + (j - j0) * GEMM_RESUME_BLOCK;
+        for (int r = r0; r < r1; r++) {
+            const unsigned long long* b = B.row(r);
+            int x = 0;
+            for (int w = 0; w < words; w++) x += popcount64(a[w] & b[w]);
+            c[r - r0] = (unsigned short)x;
+        }
+    }
+}
+
+template <typename Scores>
+static void bitMatrixKernel(const CompactRecords& jobs, const BitMatrix& jobSkills,
+                            const CompactRecords& resumes, const BitMatrix& resumeSkills,
+                            BestMatch* best, MatchStats& stats, bool showProgress) {
+    typedef typename Scores::Value Score;
+    int J = jobs.count;
+    int R = resumes.count;
+    stats.jobClasses = 0;
+    stats.resumeClasses = 0;
+    stats.pairsScored = (long long)J * R;
+    
+    unsigned short* block = new unsigned short[GEMM_JOB_BLOCK * GEMM_RESUME_BLOCK];
+    Score bestScore[GEMM_RESUME_BLOCK];
+    int bestJob[GEMM_RESUME_BLOCK];
+    
+    Progress progress(R, showProgress);
+    
+    for (int r0 = 0; r0 < R; r0 += GEMM_RESUME_BLOCK) {
+        int r1 = (r0 + GEMM_RESUME_BLOCK < R) ? r0 + GEMM_RESUME_BLOCK : R;
+        progress.update(r0);
+        
+        for (int r = r0; r < r1; r++) {
+            bestScore[r - r0] = Scores::none();
+            bestJob[r - r0] = -1;
+        }
+        
+        for (int j0 = 0; j0 < J; j0 += GEMM_JOB_BLOCK) {
+            int j1 = (j0 + GEMM_JOB_BLOCK < J) ? j0 + GEMM_JOB_BLOCK : J;
+            TraceScope tile("tile", "match", "resume", r0);
+            overlapBlock(jobSkills, j0, j1, resumeSkills, r0, r1, block);
+            
+            // Epilogue: score the block and fold it into the running bests.
+            // Jobs are visited in ascending order with a strict comparison,
+            // so the first job with the best score wins.
+            for (int r = r0; r < r1; r++) {
+                const unsigned short* c = block + (r - r0);
+                int rn = resumeSkills.rowCounts[r];
+                int ry = resumes.years[r];
+                Score sBest = bestScore[r - r0];
+                int bBest = bestJob[r - r0];
+                for (int j = j0; j < j1; j++) {
+                    Score s = Scores::score(c[(j - j0) * GEMM_RESUME_BLOCK], jobSkills.rowCounts[j],
+                                            rn, jobs.years[j], ry);
+                    if (s > sBest) { sBest = s; bBest = j; }
+                }
+                bestScore[r - r0] = sBest;
+                bestJob[r - r0] = bBest;
+            }
+        }
+        
+        for (int r = r0; r < r1; r++) {
+            int j = bestJob[r - r0];
+            int matched = 0;
+            if (j >= 0) {
+                const unsigned long long* a = jobSkills.row(j);
+                const unsigned long long* b = resumeSkills.row(r);
+                for (int w = 0; w < jobSkills.words; w++) matched += popcount64(a[w] & b[w]);
+            }
+            best[r].jobId = (j >= 0) ? jobs.ids[j] : -1;
+            best[r].score = Scores::toDouble(bestScore[r - r0]);
+            best[r].matchedSkills = matched;
+        }
+    }
+    
+    delete[] block;
+    
+    progress.finish();
+}
+
+void matchBitMatrix(const CompactRecords& jobs, const BitMatrix& jobSkills,
+                    const CompactRecords& resumes, const BitMatrix& resumeSkills,
+                    BestMatch* best, MatchStats& stats, bool showProgress) {
+    if (g_scoreMode == SCORE_FIXED) {
+        bitMatrixKernel<FixedScores>(jobs, jobSkills, resumes, resumeSkills, best, stats, showProgress);
+    } else {
+        bitMatrixKernel<FloatingScores>(jobs, jobSkills, resumes, resumeSkills, best, stats, showProgress);
+    }
+}
+
+void matchCompact(MatchEngine engine, const CompactRecords& jobs, const CompactRecords& resumes,
+                  int vocabularySize, BestMatch* best, MatchStats& stats, bool showProgress) {
+    if (engine == ENGINE_TILED) {
+        matchTiled(jobs, resumes, best, stats, showProgress);
+    } else if (engine == ENGINE_BITMATRIX) {
+        BitMatrix jobSkills, resumeSkills;
+        buildSkillMatrix(jobSkills, jobs.masks, jobs.count, vocabularySize);
+        buildSkillMatrix(resumeSkills, resumes.masks, resumes.count, vocabularySize);
+        matchBitMatrix(jobs, jobSkills, resumes, resumeSkills, best, stats, showProgress);
+    } else {
+        matchDeduplicated(jobs, resumes, best, stats, showProgress);
+    }
+}
+
+// Running top-k of one query: sorted best first. Candidates arrive in record
+// order, so a candidate that only ties the current worst is rejected and
+// equal scores stay in record order.
+struct TopKList {
+    RankedMatch* rows;
+    int k;
+    int count;
+    
+    bool accepts(double score) const {
+        return count < k || score > rows[count - 1].score;
+    }
+    
+    void insert(int id, double score, int matchedSkills) {
+        int pos = (count < k) ? count++ : k - 1;
+        while (pos > 0 && rows[pos - 1].score < score) {
+            rows[pos] = rows[pos - 1];
+            pos--;
+        }
+        rows[pos].id = id;
+        rows[pos].score = score;
+        rows[pos].matchedSkills = matchedSkills;
+    }
+};
+
+// hundredths / 100 keeps the order and ties of the fixed-point scores, so
+// the lists can rank the converted values
+template <typename Scores>
+static void topResumesKernel(const CompactRecords& jobs, const int* jobPositions, const int* ks,
+                             int queryCount, const CompactRecords& resumes,
+                             int maxK, RankedMatch* out, int* counts) {
+    TopKList* lists = new TopKList[queryCount > 0 ? queryCount : 1];
+    for (int q = 0; q < queryCount; q++) {
+        lists[q].rows = out + (long long)q * maxK;
+        lists[q].k = (ks[q] < maxK) ? ks[q] : maxK;
+        lists[q].count = 0;
+    }
+    
+    for (int r = 0; r < resumes.count; r++) {
+        unsigned long long rm = resumes.masks[r];
+        int rn = popcount64(rm);
+        int ry = resumes.years[r];
+        
+        for (int q = 0; q < queryCount; q++) {
+            if (lists[q].k <= 0) continue;
+            int j = jobPositions[q];
+            unsigned long long jm = jobs.masks[j];
+            int overlap = popcount64(jm & rm);
+            double s = Scores::toDouble(Scores::score(overlap, popcount64(jm), rn, jobs.years[j], ry));
+            if (lists[q].accepts(s)) lists[q].insert(resumes.ids[r], s, overlap);
+        }
+    }
+    
+    for (int q = 0; q < queryCount; q++) counts[q] = lists[q].count;
+    delete[] lists;
+}
+
+template <typename Scores>
+static void topJobsKernel(const CompactRecords& resumes, const int* resumePositions, const int* ks,
+                          int queryCount, const CompactRecords& jobs,
+                          int maxK, RankedMatch* out, int* counts) {
+    TopKList* lists = new TopKList[queryCount > 0 ? queryCount : 1];
+    for (int q = 0; q < queryCount; q++) {
+        lists[q].rows = out + (long long)q * maxK;
+        lists[q].k = (ks[q] < maxK) ? ks[q] : maxK;
+        lists[q].count = 0;
+    }
+    
+    for (int j = 0; j < jobs.count; j++) {
+        unsigned long long jm = jobs.masks[j];
+        int jn = popcount64(jm);
+        int jy = jobs.years[j];
+        
+        for (int q = 0; q < queryCount; q++) {
+            if (lists[q].k <= 0) continue;
+            int r = resumePositions[q];
+            unsigned long long rm = resumes.masks[r];
+            int overlap = popcount64(jm & rm);
+            double s = Scores::toDouble(Scores::score(overlap, jn, popcount64(rm), jy, resumes.years[r]));
+            if (lists[q].accepts(s)) lists[q].insert(jobs.ids[j], s, overlap);
+        }
+    }
+    
+    for (int q = 0; q < queryCount; q++) counts[q] = lists[q].count;
+    delete[] lists;
+}
+
+const char* rankingPolicyName(RankingPolicy policy) {
+    switch (policy) {
+        case RANK_ARRAY:       return "array (70% skills / 30% experience)";
+        case RANK_LINKED_LIST: return "linked list (60% skills / 40% experience + bonus)";
+        default:               return "Unknown";
+    }
+}
+
+void topResumesForJobs(const CompactRecords& jobs, const int* jobPositions, const int* ks,
+                       int queryCount, const CompactRecords& resumes,
+                       int maxK, RankedMatch* out, int* counts, RankingPolicy policy) {
+    bool fixed = g_scoreMode == SCORE_FIXED;
+    if (policy == RANK_LINKED_LIST) {
+        if (fixed) topResumesKernel<LinkedListFixedScores>(jobs, jobPositions, ks, queryCount, resumes, maxK, out, counts);
+        else topResumesKernel<LinkedListFloatingScores>(jobs, jobPositions, ks, queryCount, resumes, maxK, out, counts);
+    } else {
+        if (fixed) topResumesKernel<FixedScores>(jobs, jobPositions, ks, queryCount, resumes, maxK, out, counts);
+        else topResumesKernel<FloatingScores>(jobs, jobPositions, ks, queryCount, resumes, maxK, out, counts);
+    }
+}
+
+void topJobsForResumes(const CompactRecords& resumes, const int* resumePositions, const int* ks,
+                       int queryCount, const CompactRecords& jobs,
+                       int maxK, RankedMatch* out, int* counts, RankingPolicy policy) {
+    bool fixed = g_scoreMode == SCORE_FIXED;
+    if (policy == RANK_LINKED_LIST) {
+        if (fixed) topJobsKernel<LinkedListFixedScores>(resumes, resumePositions, ks, queryCount, jobs, maxK, out, counts);
+        else topJobsKernel<LinkedListFloatingScores>(resumes, resumePositions, ks, queryCount, jobs, maxK, out, counts);
+    } else {
+        if (fixed) topJobsKernel<FixedScores>(resumes, resumePositions, ks, queryCount, jobs, maxK, out, counts);
+        else topJobsKernel<FloatingScores>(resumes, resumePositions, ks, queryCount, jobs, maxK, out, counts);
+    }
+}
+
+#ifndef _WIN32
+
+// Write/read a whole buffer, retrying short transfers and interrupts
+static bool writeAll(int fd, const void* data, long long length) {
+    const char* p = (const char*)data;
+    while (length > 0) {
+        ssize_t n = ::write(fd, p, (size_t)length);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        p += n;
+        length -= n;
+    }
+    return true;
+}
+
+static bool readAll(int fd, void* data, long long length) {
+    char* p = (char*)data;
+    while (length > 0) {
+        ssize_t n = ::read(fd, p, (size_t)length);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        if (n == 0) return false;       // worker exited early
+        p += n;
+        length -= n;
+    }
+    return true;
+}
+
+// Worker side: match one job range and stream the results to the coordinator
+static void runShardWorker(MatchEngine engine, const CompactRecords& jobs, int j0, int j1,
+                           const CompactRecords& resumes, int vocabularySize, int fd) {
+    CompactRecords shard;
+    shard.resize(j1 - j0);
+    for (int j = j0; j < j1; j++) {
+        shard.ids[j - j0] = jobs.ids[j];
+        shard.years[j - j0] = jobs.years[j];
+        shard.masks[j - j0] = jobs.masks[j];
+    }
+    
+    BestMatch* best = new BestMatch[resumes.count > 0 ? resumes.count : 1];
+    MatchStats stats;
+    matchCompact(engine, shard, resumes, vocabularySize, best, stats, false);
+    
+    bool ok = writeAll(fd, &stats.pairsScored, sizeof(stats.pairsScored)) &&
+              writeAll(fd, best, (long long)sizeof(BestMatch) * resumes.count);
+    delete[] best;
+    ::close(fd);
+    _exit(ok ? 0 : 1);
+}
+
+bool matchSharded(MatchEngine engine, const CompactRecords& jobs, const CompactRecords& resumes,
+                  int vocabularySize, int shards, BestMatch* best, MatchStats& stats) {
+    int J = jobs.count;
+    int R = resumes.count;
+    if (shards < 1) shards = 1;
+    if (shards > J && J > 0) shards = J;
+    
+    pid_t* pids = new pid_t[shards];
+    int* fds = new int[shards];
+    int started = 0;
+    bool ok = true;
+    
+    std::cout.flush();      // don't let children inherit buffered output
+    
+    for (int s = 0; s < shards; s++) {
+        int j0 = (int)((long long)J * s / shards);
+        int j1 = (int)((long long)J * (s + 1) / shards);
+        
+        int pipefd[2];
+        if (pipe(pipefd) != 0) {
+            ok = false;
+            break;
+        }
+        pid_t pid = fork();
+        if (pid < 0) {
+            ::close(pipefd[0]);
+            ::close(pipefd[1]);
+            ok = false;
+            break;
+        }
+        if (pid == 0) {
+            ::close(pipefd[0]);
+            for (int k = 0; k < started; k++) ::close(fds[k]);
+            runShardWorker(engine, jobs, j0, j1, resumes, vocabularySize, pipefd[1]);
+        }
+        
+        ::close(pipefd[1]);
+        pids[started] = pid;
+        fds[started] = pipefd[0];
+        started++;
+    }
+    
+    // Merge in shard order: a later shard only wins with a strictly higher
+    // score, so ties keep the job that comes first overall
+    BestMatch* merged = new BestMatch[R > 0 ? R : 1];
+    BestMatch* incoming = new BestMatch[R > 0 ? R : 1];
+    long long pairs = 0;
+    
+    for (int s = 0; s < started; s++) {
+        long long shardPairs = 0;
+        traceBegin("wait for shard", "shard", "shard", s);
+        bool received = ok &&
+            readAll(fds[s], &shardPairs, sizeof(shardPairs)) &&
+            readAll(fds[s], incoming, (long long)sizeof(BestMatch) * R);
+        traceEnd("wait for shard", "shard");
+        if (!received) {
+            ok = false;
+        } else {
+            TraceScope scope("merge shard", "shard", "shard", s);
+            pairs += shardPairs;
+            for (int r = 0; r < R; r++) {
+                if (incoming[r].jobId < 0) continue;
+                if (merged[r].jobId < 0 || incoming[r].score > merged[r].score) merged[r] = incoming[r];
+            }
+        }
+        ::close(fds[s]);
+    }
+    
+    for (int s = 0; s < started; s++) {
+        int status = 0;
+        while (waitpid(pids[s], &status, 0) < 0 && errno == EINTR) {}
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) ok = false;
+    }
+    
+    if (ok) {
+        for (int r = 0; r < R; r++) best[r] = merged[r];
+        stats.jobClasses = 0;
+        stats.resumeClasses = 0;
+        stats.pairsScored = pairs;
+    }
+    
+    delete[] merged;
+    delete[] incoming;
+    delete[] pids;
+    delete[] fds;
+    return ok;
+}
+
+#else
+
+bool matchSharded(MatchEngine, const CompactRecords&, const CompactRecords&,
+                  int, int, BestMatch*, MatchStats&) {
+    return false;   // no fork() on Windows; callers match in-process
+}
+
+#endif
+
+} // namespace arr
@@ -0,0 +1,240 @@
+#ifndef ARRAYMATCHING_HPP
+#define ARRAYMATCHING_HPP
+
+#include "../shared/ScoringCore.hpp"
+
+// Matching kernels for the array implementation.
+// Kernels work on a compact view of the records (id, years and a skill bit
+// mask per record) instead of the full JobA/ResumeA structures, so the data
+// a kernel streams over is 24 bytes per record rather than kilobytes.
+
+namespace arr {
+
+// Best job found for one resume
+struct BestMatch {
+    int jobId = -1;
+    double score = 0.0;
+    int matchedSkills = 0;
+};
+
+// Structure-of-arrays view of a record set (bit i of a mask = vocabulary skill i)
+struct CompactRecords {
+    int count;
+    int* ids;
+    int* years;
+    unsigned long long* masks;
+    
+    CompactRecords();
+    ~CompactRecords();
+    CompactRecords(const CompactRecords&) = delete;
+    CompactRecords& operator=(const CompactRecords&) = delete;
+    
+    void resize(int n);
+};
+
+// Id -> position table of a record set. Ids are dense (jobs 1..J, resumes
+// 101..), so this is one array over [firstId, firstId + span).
+struct PositionIndex {
+    int firstId;
+    int span;
+    int* positions;         // -1 where no record has the id
+    
+    PositionIndex();
+    ~PositionIndex();
+    PositionIndex(const PositionIndex&) = delete;
+    PositionIndex& operator=(const PositionIndex&) = delete;
+    
+    void build(const CompactRecords& records);
+    
+    // Position of a record id, or -1
+    int find(int id) const {
+        unsigned int offset = (unsigned int)(id - firstId);
+        return offset < (unsigned int)span ? positions[offset] : -1;
+    }
+};
+
+// Compact form of one published data version (see ArrayStore in ArrayImpl.cpp)
+struct CompactStore {
+    long long version = 0;
+    CompactRecords jobs;
+    CompactRecords resumes;
+    PositionIndex jobPositions;
+    PositionIndex resumePositions;
+};
+
+// Array scoring (70% skills / 30% experience), see ScoringCore.hpp
+typedef ScoringCore<ArrayScoringPolicy> ArrayScoring;
+extern const ScoreTables<ArrayScoringPolicy> SCORE_TABLES;
+extern const FixedScoreTables<ArrayScoringPolicy> FIXED_SCORE_TABLES;
+
+// Score domains the kernels can rank in. Floating point is the default;
+// fixed point ranks by integer hundredths, so pairs whose scores print the
+// same are exact ties and go to the job that comes first in every engine.
+// Results are reported as doubles either way (hundredths / 100).
+// The two modes can disagree: where two jobs score within the same
+// hundredth, floating point keeps the strictly higher double and fixed point
+// the first job, and a score exactly on a half the double can't hold prints
+// per the double's rounding error (see ScoringCore::scoreHundredths).
+// tools/score_rounding_check.cpp checks the rounding against the printed
+// scores.
+enum ScoreMode {
+    SCORE_FLOATING,
+    SCORE_FIXED,
+    SCORE_MODE_COUNT
+};
+
+const char* scoreModeName(ScoreMode mode);
+ScoreMode scoreMode();
+void setScoreMode(ScoreMode mode);
+
+// The kernels are instantiated once per domain
+struct FloatingScores {
+    typedef double Value;
+    static inline Value none() { return -1.0; }
+    static inline Value score(int overlap, int jobSkills, int resumeSkills, int required, int actual) {
+        return SCORE_TABLES.score(overlap, jobSkills, resumeSkills, required, actual);
+    }
+    static inline double toDouble(Value v) { return v < 0 ? 0.0 : v; }
+};
+
+struct FixedScores {
+    typedef short Value;     // 0-10000 hundredths
+    static inline Value none() { return -1; }
+    static inline Value score(int overlap, int jobSkills, int resumeSkills, int required, int actual) {
+        return FIXED_SCORE_TABLES.score(overlap, jobSkills, resumeSkills, required, actual);
+    }
+    static inline double toDouble(Value v) { return v < 0 ? 0.0 : v / 100.0; }
+};
+
+// Number of set bits. Inline SWAR version: without -mpopcnt the builtin
+// becomes a library call, which dominates the all-pairs kernels.
+static inline int popcount64(unsigned long long x) {
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (int)((x * 0x0101010101010101ULL) >> 56);
+}
+
+// Score of one job/resume pair from their masks and years
+// (same result as scoring the extracted skill lists directly)
+template <typename Scores>
+static inline typename Scores::Value compactScore(unsigned long long jobMask, int jobYears,
+                                                  unsigned long long resMask, int resYears) {
+    return Scores::score(popcount64(jobMask & resMask),
+                         popcount64(jobMask), popcount64(resMask),
+                         jobYears, resYears);
+}
+
+// Packed bit matrix, one row per record and one column per vocabulary
+// skill; rows are padded to whole 64-bit words
+struct BitMatrix {
+    int rows;
+    int cols;
+    int words;                      // 64-bit words per row
+    unsigned long long* bits;       // rows * words, row-major
+    int* rowCounts;                 // set bits per row
+    
+    BitMatrix();
+    ~BitMatrix();
+    BitMatrix(const BitMatrix&) = delete;
+    BitMatrix& operator=(const BitMatrix&) = delete;
+    
+    // All bits cleared
+    void resize(int rows, int cols);
+    void set(int row, int col);
+    const unsigned long long* row(int r) const { return bits + (long long)r * words; }
+    
+    // Fill rowCounts once all bits are set
+    void finish();
+};
+
+// Record x skill matrix from skill masks (vocabularySize <= 64)
+void buildSkillMatrix(BitMatrix& m, const unsigned long long* masks, int count, int vocabularySize);
+
+// Statistics reported by the kernels
+struct MatchStats {
+    int jobClasses = 0;
+    int resumeClasses = 0;
+    long long pairsScored = 0;
+};
+
+// Matching engines selectable from the array menu. All of them produce the
+// best job per resume with ties going to the job that comes first, so they
+// write identical results. They rank in the current scoreMode().
+enum MatchEngine {
+    ENGINE_REFERENCE,   // pair-by-pair loop over the full records (ArrayImpl.cpp)
+    ENGINE_DEDUP,       // one pair per distinct (skills, years) profile
+    ENGINE_TILED,       // cache-blocked all-pairs kernel over compact records
+    ENGINE_BITMATRIX,   // blocked AND+popcount product of the skill bit matrices
+    ENGINE_COUNT
+};
+
+const char* engineName(MatchEngine engine);
+
+// Working memory of an engine (compact records and kernel scratch), used to
+// size batches in streaming mode
+long long engineBytesPerJob(MatchEngine engine);
+long long engineBytesPerResume(MatchEngine engine, int vocabularySize);
+
+// Score one representative pair per (skills, years) profile class
+void matchDeduplicated(const CompactRecords& jobs, const CompactRecords& resumes,
+                       BestMatch* best, MatchStats& stats, bool showProgress = true);
+
+// Score every pair. Jobs are processed in tiles small enough to stay in L1
+// while a block of resumes is streamed past them, several resumes per pass.
+void matchTiled(const CompactRecords& jobs, const CompactRecords& resumes,
+                BestMatch* best, MatchStats& stats, bool showProgress = true);
+
+// Overlaps of all pairs are the Boolean product (job x skill) * (skill x resume),
+// i.e. AND+popcount of a job row with a resume row. The product is computed
+// block by block and each block is scored and reduced to the running best
+// per resume right away, so the J x R overlap matrix is never stored.
+// Works for any vocabulary width; ids and years come from the compact records.
+void matchBitMatrix(const CompactRecords& jobs, const BitMatrix& jobSkills,
+                    const CompactRecords& resumes, const BitMatrix& resumeSkills,
+                    BestMatch* best, MatchStats& stats, bool showProgress = true);
+
+// Run one of the compact engines (not ENGINE_REFERENCE, which needs the full records)
+void matchCompact(MatchEngine engine, const CompactRecords& jobs, const CompactRecords& resumes,
+                  int vocabularySize, BestMatch* best, MatchStats& stats, bool showProgress = true);
+
+// One entry of a ranked result
+struct RankedMatch {
+    int id;
+    double score;
+    int matchedSkills;
+};
+
+// Scoring policy the top-k queries rank with (see ScoringCore.hpp)
+enum RankingPolicy {
+    RANK_ARRAY,         // ArrayScoringPolicy, as the full matching runs
+    RANK_LINKED_LIST    // LinkedListScoringPolicy, as the linked list menus 9/10
+};
+
+const char* rankingPolicyName(RankingPolicy policy);
+
+// Batched top-k queries. Every query of a batch is answered in one pass over
+// the other side's records (outer loop over records, inner loop over the
+// queries), so a batch costs about as much memory traffic as one query.
+// Query i's results go to out[i * maxK ...], best first (ties: earlier
+// record first, in the current scoreMode()), and counts[i] receives how
+// many there are.
+void topResumesForJobs(const CompactRecords& jobs, const int* jobPositions, const int* ks,
+                       int queryCount, const CompactRecords& resumes,
+                       int maxK, RankedMatch* out, int* counts, RankingPolicy policy);
+void topJobsForResumes(const CompactRecords& resumes, const int* resumePositions, const int* ks,
+                       int queryCount, const CompactRecords& jobs,
+                       int maxK, RankedMatch* out, int* counts, RankingPolicy policy);
+
+// Multi-process matching: the coordinator splits the jobs into contiguous
+// ranges, forks one worker per range to run matchCompact on it, and merges
+// the per-resume bests the workers stream back over pipes. Ranges are merged
+// in order with a strict comparison, so the result is the same as matching
+// in one process. Returns false (best untouched) if workers can't be started
+// or one of them fails; POSIX only.
+bool matchSharded(MatchEngine engine, const CompactRecords& jobs, const CompactRecords& resumes,
+                  int vocabularySize, int shards, BestMatch* best, MatchStats& stats);
+
+} // namespace arr
+
+#endif // ARRAYMATCHING_HPP
@@ -0,0 +1,480 @@
+// Local query server for the array engine (see ArrayServer.hpp)
+
+#include "ArrayServer.hpp"
+#include "QueryProtocol.hpp"
+#include "../shared/BoundedQueue.hpp"
+#include "../shared/Tracer.hpp"
+#include <iostream>
+#include <iomanip>
+
+#ifndef _WIN32
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#endif
+
+namespace arr {
+
+#ifndef _WIN32
+
+typedef std::chrono::steady_clock ServerClock;
+
+// One client. Its reader thread and the batch worker queue response frames
+// in outbound; the connection's writer thread writes them out, waiting for
+// the socket to become writable when its buffer is full. A client that
+// accepts nothing for writeTimeoutMs has stopped reading and is dropped, so
+// neither the batch worker nor other clients ever wait on it. The socket is
+// closed when the last user lets go.
+struct Connection {
+    int fd;
+    std::mutex writeLock;
+    std::condition_variable wake;   // writer: frames queued, or nothing more to come
+    std::vector<char> outbound;     // frames not yet written (under writeLock)
+    int inFlight;                   // requests queued but not answered (under writeLock)
+    bool readerDone;                // under writeLock
+    std::atomic<bool> dropped;
+    std::atomic<bool> finished;     // writer done; the reader is done or ending
+
+    explicit Connection(int fd) : fd(fd), inFlight(0), readerDone(false), dropped(false), finished(false) {}
+    ~Connection() { ::close(fd); }
+
+    // A request was queued for the batch worker
+    void expectAnswer() {
+        std::lock_guard<std::mutex> guard(writeLock);
+        inFlight++;
+    }
+
+    // Queue a frame (answered: it answers a queued request). False if the
+    // client was dropped.
+    bool send(const char* frame, int length, bool answered = false) {
+        std::lock_guard<std::mutex> guard(writeLock);
+        if (answered) inFlight--;
+        if (!dropped.load()) outbound.insert(outbound.end(), frame, frame + length);
+        wake.notify_one();
+        return !dropped.load();
+    }
+
+    void readerFinished() {
+        std::lock_guard<std::mutex> guard(writeLock);
+        readerDone = true;
+        wake.notify_one();
+    }
+};
+
+struct PendingQuery {
+    std::shared_ptr<Connection> connection;
+    QueryRequest request;
+    ServerClock::time_point received;
+};
+
+struct ServerState {
+    EpochDomain& epochs;
+    const RcuPtr<CompactStore>& store;
+    QueryServerOptions options;
+    MpmcQueue<PendingQuery*> queue;
+    std::atomic<bool> stopping;
+    int stopPipe[2];
+
+    // Batch worker only
+    std::vector<long long> latenciesUs;
+    long long batches;
+    int largestBatch;
+    
+    std::atomic<int> droppedClients;    // stopped reading their responses
+
+    ServerState(EpochDomain& e, const RcuPtr<CompactStore>& s, const QueryServerOptions& o)
+        : epochs(e), store(s), options(o), queue(4096), stopping(false),
+          batches(0), largestBatch(0), droppedClients(0) {}
+
+    void requestStop() {
+        if (stopping.exchange(true)) return;
+        char wake = 1;
+        ssize_t ignored = ::write(stopPipe[1], &wake, 1);
+        (void)ignored;
+    }
+};
+
+static void sendStatus(Connection& connection, unsigned int requestId, int status) {
+    char frame[QUERY_MAX_FRAME + 4];
+    int length = encodeResponse(requestId, status, nullptr, 0, frame);
+    connection.send(frame, length);
+}
+
+// Per-connection reader: decode, validate and queue requests
+static void readRequests(ServerState& state, std::shared_ptr<Connection> connection) {
+    traceThreadName("client reader");
+    char body[QUERY_MAX_FRAME];
+    unsigned int length;
+
+    while (queryReadFrame(connection->fd, body, length)) {
+        QueryRequest request;
+        if (!decodeRequest(body, length, request)) break;       // out of sync, drop the client
+
+        if (request.type == QUERY_SHUTDOWN) {
+            sendStatus(*connection, request.requestId, QUERY_OK);
+            state.requestStop();
+            break;
+        }
+        if ((request.type != QUERY_CANDIDATES_FOR_JOB && request.type != QUERY_JOBS_FOR_RESUME) ||
+            request.k < 1 || request.k > QUERY_MAX_K) {
+            sendStatus(*connection, request.requestId, QUERY_BAD_REQUEST);
+            continue;
+        }
+
+        PendingQuery* pending = new PendingQuery;
+        pending->connection = connection;
+        pending->request = request;
+        pending->received = ServerClock::now();
+        connection->expectAnswer();
+        state.queue.push(pending);
+    }
+    connection->readerFinished();
+}
+
+// Per-connection writer: write queued frames until the reader is done and
+// every queued request has been answered
+static void writeResponses(ServerState& state, std::shared_ptr<Connection> connection) {
+    traceThreadName("client writer");
+    Connection& c = *connection;
+    std::vector<char> sending;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(c.writeLock);
+            c.wake.wait(lock, [&c]() {
+                return !c.outbound.empty() || c.dropped.load() || (c.readerDone && c.inFlight == 0);
+            });
+            if (c.outbound.empty() || c.dropped.load()) break;
+            sending.swap(c.outbound);
+        }
+
+        size_t sent = 0;
+        bool stalled = false;
+        while (sent < sending.size()) {
+            ssize_t n = ::send(c.fd, sending.data() + sent, sending.size() - sent, MSG_NOSIGNAL | MSG_DONTWAIT);
+            if (n > 0) {
+                sent += (size_t)n;
+                continue;
+            }
+            if (n < 0 && errno == EINTR) continue;
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                pollfd out;
+                out.fd = c.fd;
+                out.events = POLLOUT;
+                int ready = ::poll(&out, 1, state.options.writeTimeoutMs);
+                if (ready > 0 || (ready < 0 && errno == EINTR)) continue;   // errors show up in send
+                stalled = ready == 0;
+            }
+            break;      // the client left, or accepted nothing for the whole timeout
+        }
+        if (sent < sending.size()) {
+            // A partly written frame leaves the stream unusable: drop the client
+            std::lock_guard<std::mutex> guard(c.writeLock);
+            c.dropped.store(true);
+            c.outbound.clear();
+            ::shutdown(c.fd, SHUT_RDWR);        // ends the reader too
+            if (stalled) state.droppedClients++;
+            break;
+        }
+        sending.clear();
+    }
+    c.finished.store(true);
+}
+
+// Answer one batch: one pass over the resumes for all job queries and one
+// pass over the jobs for all resume queries. The read section covers the
+// scoring only, so a version replaced meanwhile can be freed right after.
+static void answerBatch(ServerState& state, PendingQuery** batch, int n,
+                        int* positions, int* ks, int* slots, RankedMatch* results, int* counts) {
+    TraceScope scope("query batch", "server", "requests", n);
+    for (int i = 0; i < n; i++) counts[i] = -1;     // -1 = not found
+
+    {
+        RcuReadGuard guard(state.epochs);
+        const CompactStore* data = state.store.read(guard);
+        if (data != nullptr) {
+            for (int pass = 0; pass < 2; pass++) {
+                int type = (pass == 0) ? QUERY_CANDIDATES_FOR_JOB : QUERY_JOBS_FOR_RESUME;
+                const PositionIndex& own = (pass == 0) ? data->jobPositions : data->resumePositions;
+
+                int queries = 0;
+                for (int i = 0; i < n; i++) {
+                    if (batch[i]->request.type != type) continue;
+                    if (batch[i]->connection->dropped.load()) continue;     // nobody to answer
+                    int pos = own.find(batch[i]->request.id);
+                    if (pos < 0) continue;
+                    positions[queries] = pos;
+                    ks[queries] = batch[i]->request.k;
+                    slots[queries] = i;
+                    queries++;
+                }
+                if (queries == 0) continue;
+
+                // Query q's rows land in slot q; moved to the request's slot below
+                RankedMatch* passResults = results + (long long)n * QUERY_MAX_K;
+                int* passCounts = counts + n;
+                if (pass == 0) {
+                    topResumesForJobs(data->jobs, positions, ks, queries, data->resumes,
+                                      QUERY_MAX_K, passResults, passCounts, state.options.ranking);
+                } else {
+                    topJobsForResumes(data->resumes, positions, ks, queries, data->jobs,
+                                      QUERY_MAX_K, passResults, passCounts, state.options.ranking);
+                }
+                for (int q = 0; q < queries; q++) {
+                    int i = slots[q];
+                    counts[i] = passCounts[q];
+                    for (int r = 0; r < passCounts[q]; r++) {
+                        results[(long long)i * QUERY_MAX_K + r] = passResults[(long long)q * QUERY_MAX_K + r];
+                    }
+                }
+            }
+        }
+    }
+
+    char frame[QUERY_MAX_FRAME + 4];
+    QueryRow rows[QUERY_MAX_K];
+    for (int i = 0; i < n; i++) {
+        int length;
+        if (counts[i] < 0) {
+            length = encodeResponse(batch[i]->request.requestId, QUERY_NOT_FOUND, nullptr, 0, frame);
+        } else {
+            const RankedMatch* found = results + (long long)i * QUERY_MAX_K;
+            for (int r = 0; r < counts[i]; r++) {
+                rows[r].id = found[r].id;
+                rows[r].score = found[r].score;
+                rows[r].matchedSkills = found[r].matchedSkills;
+            }
+            length = encodeResponse(batch[i]->request.requestId, QUERY_OK, rows, counts[i], frame);
+        }
+        if (batch[i]->connection->send(frame, length, true)) {     // a client that left is just skipped
+            state.latenciesUs.push_back(std::chrono::duration_cast<std::chrono::microseconds>(
+                ServerClock::now() - batch[i]->received).count());
+        }
+        delete batch[i];
+    }
+}
+
+// Batch worker: collect up to maxBatch requests within the batch window
+static void processBatches(ServerState& state) {
+    traceThreadName("batch worker");
+    int maxBatch = state.options.maxBatch;
+    PendingQuery** batch = new PendingQuery*[maxBatch];
+    int* positions = new int[maxBatch];
+    int* ks = new int[maxBatch];
+    int* slots = new int[maxBatch];
+    int* counts = new int[2 * maxBatch];
+    RankedMatch* results = new RankedMatch[2LL * maxBatch * QUERY_MAX_K];
+
+    PendingQuery* first;
+    while (state.queue.pop(first)) {
+        int n = 0;
+        batch[n++] = first;
+
+        ServerClock::time_point deadline =
+            ServerClock::now() + std::chrono::microseconds(state.options.batchWindowUs);
+        QueueBackoff backoff;
+        while (n < maxBatch) {
+            PendingQuery* next;
+            if (state.queue.tryPop(next)) {
+                batch[n++] = next;
+                continue;
+            }
+            if (ServerClock::now() >= deadline) break;
+            backoff.wait();
+        }
+
+        answerBatch(state, batch, n, positions, ks, slots, results, counts);
+        state.epochs.reclaim();     // versions replaced while the batch was scoring
+        state.batches++;
+        if (n > state.largestBatch) state.largestBatch = n;
+    }
+
+    delete[] batch;
+    delete[] positions;
+    delete[] ks;
+    delete[] slots;
+    delete[] counts;
+    delete[] results;
+}
+
+static long long percentile(const std::vector<long long>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    long long rank = (long long)(p * sorted.size() + 0.999999);
+    if (rank < 1) rank = 1;
+    if (rank > (long long)sorted.size()) rank = sorted.size();
+    return sorted[rank - 1];
+}
+
+static void printServerStats(ServerState& state, long long servedUs) {
+    std::vector<long long>& lat = state.latenciesUs;
+    std::sort(lat.begin(), lat.end());
+    long long requests = (long long)lat.size();
+
+    std::cout << "\nQuery Server Summary\n";
+    std::cout << "-----------------------------------------------\n";
+    std::cout << "Requests answered : " << requests << "\n";
+    std::cout << "Batches           : " << state.batches << "\n";
+    std::cout << "Average batch     : " << std::fixed << std::setprecision(2)
+              << (state.batches > 0 ? (double)requests / state.batches : 0.0)
+              << " (largest " << state.largestBatch << ")\n";
+    std::cout << "Throughput        : " << std::fixed << std::setprecision(0)
+              << (servedUs > 0 ? requests * 1000000.0 / servedUs : 0.0) << " requests/s over "
+              << std::setprecision(1) << servedUs / 1000000.0 << " s\n";
+    std::cout << "Latency (us)      : p50 " << percentile(lat, 0.50)
+              << "  p90 " << percentile(lat, 0.90)
+              << "  p99 " << percentile(lat, 0.99)
+              << "  p99.9 " << percentile(lat, 0.999)
+              << "  max " << (lat.empty() ? 0 : lat.back()) << "\n";
+    if (state.droppedClients.load() > 0) {
+        std::cout << "Clients dropped   : " << state.droppedClients.load() << " (not reading responses)\n";
+    }
+    std::cout << "-----------------------------------------------\n";
+}
+
+// True only for a socket nobody is listening on (left over from a server
+// that didn't shut down cleanly)
+static bool isStaleSocket(const sockaddr_un& address) {
+    int probe = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (probe < 0) return false;
+    bool refused = ::connect(probe, (const sockaddr*)&address, sizeof(address)) != 0 &&
+                   errno == ECONNREFUSED;
+    ::close(probe);
+    return refused;
+}
+
+bool runQueryServer(const char* socketPath, EpochDomain& epochs,
+                    const RcuPtr<CompactStore>& store, const QueryServerOptions& options) {
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (strlen(socketPath) >= sizeof(address.sun_path)) {
+        std::cout << "Socket path is too long.\n";
+        return false;
+    }
+    strcpy(address.sun_path, socketPath);
+
+    // Only a dead socket may be replaced; never a regular file or a live server
+    struct stat info;
+    if (::lstat(socketPath, &info) == 0) {
+        if (!S_ISSOCK(info.st_mode) || !isStaleSocket(address)) {
+            std::cout << "Could not listen on " << socketPath << ": path exists.\n";
+            return false;
+        }
+        ::unlink(socketPath);
+    }
+
+    int listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        std::cout << "Could not create socket.\n";
+        return false;
+    }
+    if (::bind(listenFd, (sockaddr*)&address, sizeof(address)) != 0 || ::listen(listenFd, 64) != 0) {
+        std::cout << "Could not listen on " << socketPath << ".\n";
+        ::close(listenFd);
+        return false;
+    }
+
+    QueryServerOptions opts = options;
+    if (opts.maxBatch < 1) opts.maxBatch = 1;
+    if (opts.batchWindowUs < 0) opts.batchWindowUs = 0;
+    if (opts.writeTimeoutMs < 1) opts.writeTimeoutMs = 1;
+
+    ServerState state(epochs, store, opts);
+    if (::pipe(state.stopPipe) != 0) {
+        std::cout << "Could not create stop pipe.\n";
+        ::close(listenFd);
+        ::unlink(socketPath);
+        return false;
+    }
+
+    std::cout << "Query server listening on " << socketPath << "\n";
+    std::cout << "Batching up to " << opts.maxBatch << " requests within "
+              << opts.batchWindowUs << " us\n";
+    std::cout << "Scoring: " << rankingPolicyName(opts.ranking) << "\n";
+    std::cout << "Waiting for a shutdown request...\n";
+    std::cout.flush();
+
+    ServerClock::time_point started = ServerClock::now();
+    std::thread worker(processBatches, std::ref(state));
+
+    struct Client {
+        std::shared_ptr<Connection> connection;
+        std::thread reader;
+        std::thread writer;
+    };
+    std::vector<Client> clients;
+
+    while (!state.stopping.load()) {
+        pollfd fds[2];
+        fds[0].fd = listenFd;
+        fds[0].events = POLLIN;
+        fds[1].fd = state.stopPipe[0];
+        fds[1].events = POLLIN;
+        if (::poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (fds[1].revents != 0) break;
+        if ((fds[0].revents & POLLIN) == 0) continue;
+
+        int fd = ::accept(listenFd, nullptr, nullptr);
+        if (fd < 0) continue;
+
+        // Forget clients that have disconnected
+        for (size_t i = 0; i < clients.size(); ) {
+            if (clients[i].connection->finished.load()) {
+                clients[i].reader.join();
+                clients[i].writer.join();
+                clients[i] = std::move(clients.back());
+                clients.pop_back();
+            } else {
+                i++;
+            }
+        }
+
+        Client client;
+        client.connection = std::make_shared<Connection>(fd);
+        client.reader = std::thread(readRequests, std::ref(state), client.connection);
+        client.writer = std::thread(writeResponses, std::ref(state), client.connection);
+        clients.push_back(std::move(client));
+    }
+
+    // Wake the readers, let the worker answer what was already queued and
+    // the writers send it
+    for (size_t i = 0; i < clients.size(); i++) ::shutdown(clients[i].connection->fd, SHUT_RD);
+    for (size_t i = 0; i < clients.size(); i++) clients[i].reader.join();
+    state.queue.close();
+    worker.join();
+    for (size_t i = 0; i < clients.size(); i++) clients[i].writer.join();
+    clients.clear();
+    long long servedUs = std::chrono::duration_cast<std::chrono::microseconds>(
+        ServerClock::now() - started).count();
+
+    ::close(listenFd);
+    ::close(state.stopPipe[0]);
+    ::close(state.stopPipe[1]);
+    ::unlink(socketPath);
+
+    printServerStats(state, servedUs);
+    return true;
+}
+
+#else
+
+bool runQueryServer(const char*, EpochDomain&, const RcuPtr<CompactStore>&, const QueryServerOptions&) {
+    std::cout << "The query server needs Unix domain sockets (not available on Windows).\n";
+    return false;
+}
+
+#endif
+
+} // namespace arr
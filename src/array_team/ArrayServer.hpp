@@ -0,0 +1,42 @@
+#ifndef ARRAYSERVER_HPP
+#define ARRAYSERVER_HPP
+
+#include "ArrayMatching.hpp"
+#include "../shared/Rcu.hpp"
+
+namespace arr {
+
+// Local query server (protocol: QueryProtocol.hpp).
+//
+// Each client connection has a reader thread that decodes requests and
+// queues them. A single batch worker takes the first waiting request, keeps
+// collecting for up to batchWindowUs or until maxBatch requests are in hand,
+// and answers the whole batch with one pass over the current CompactStore
+// (see topResumesForJobs). Data published while the server runs is picked up
+// by the next batch, and the worker only holds a read section while scoring,
+// so replaced versions are freed while the server runs.
+//
+// Responses are queued per connection and written by that connection's
+// writer thread, which waits for the socket to drain when its buffer is
+// full. A client that accepts nothing for writeTimeoutMs has stopped
+// reading and is disconnected; it never holds up the worker.
+//
+// Queries answer the linked list menus 9/10 (best resumes for a job, best
+// jobs for a resume), so by default they are scored with that engine's
+// policy; ranking can be switched to the array policy.
+struct QueryServerOptions {
+    int maxBatch = 64;
+    int batchWindowUs = 200;
+    int writeTimeoutMs = 2000;
+    RankingPolicy ranking = RANK_LINKED_LIST;
+};
+
+// Serves until a client sends QUERY_SHUTDOWN, then prints per-request latency
+// percentiles and batching statistics. Returns false if the socket can't be
+// set up; POSIX only.
+bool runQueryServer(const char* socketPath, EpochDomain& epochs,
+                    const RcuPtr<CompactStore>& store, const QueryServerOptions& options);
+
+} // namespace arr
+
+#endif // ARRAYSERVER_HPP
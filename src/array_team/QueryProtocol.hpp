@@ -0,0 +1,181 @@
+#ifndef QUERYPROTOCOL_HPP
+#define QUERYPROTOCOL_HPP
+
+#include <cstring>
+
+// Wire format of the query server (local Unix domain socket).
+//
+// Every message is a frame: a 4-byte body length followed by the body.
+// Integers and doubles are in host byte order; client and server always run
+// on the same machine.
+//
+//   request body : requestId (u32) | type (u8) | id (i32) | k (i32)
+//   response body: requestId (u32) | status (u8) | count (i32)
+//                  | count x [ id (i32) | score (f64) | matchedSkills (i32) ]
+//
+// Responses on one connection may come back in a different order than the
+// requests were sent; clients match them up by requestId.
+//
+// Scores (0-100) follow the linked list engine's policy by default: 60%
+// skills / 40% experience, with experience above the requirement scored
+// 50 + 50 * actual/required (capped at 100), the same as the linked list
+// menus 9/10. The full array matching (menu 7) scores 70% / 30% with a
+// linear experience curve, so its scores differ from the server's for the
+// same pair unless the server runs with RANK_ARRAY (ArrayServer.hpp).
+// Skills are matched on the array engine's vocabulary.
+
+#ifndef _WIN32
+#include <cerrno>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace arr {
+
+enum QueryType {
+    QUERY_CANDIDATES_FOR_JOB = 1,   // best resumes for job `id`
+    QUERY_JOBS_FOR_RESUME    = 2,   // best jobs for resume `id`
+    QUERY_SHUTDOWN           = 3    // stop the server
+};
+
+enum QueryStatus {
+    QUERY_OK          = 0,
+    QUERY_NOT_FOUND   = 1,
+    QUERY_BAD_REQUEST = 2
+};
+
+static const int QUERY_MAX_K = 100;
+static const int QUERY_REQUEST_SIZE = 4 + 1 + 4 + 4;
+static const int QUERY_ROW_SIZE = 4 + 8 + 4;
+static const int QUERY_RESPONSE_HEADER = 4 + 1 + 4;
+static const int QUERY_MAX_FRAME = QUERY_RESPONSE_HEADER + QUERY_MAX_K * QUERY_ROW_SIZE;
+
+struct QueryRequest {
+    unsigned int requestId = 0;
+    int type = 0;
+    int id = 0;
+    int k = 0;
+};
+
+struct QueryRow {
+    int id;
+    double score;
+    int matchedSkills;
+};
+
+// Append/read a field of a frame body
+template <typename T>
+static inline char* putField(char* p, T value) {
+    memcpy(p, &value, sizeof(T));
+    return p + sizeof(T);
+}
+
+template <typename T>
+static inline const char* getField(const char* p, T& value) {
+    memcpy(&value, p, sizeof(T));
+    return p + sizeof(T);
+}
+
+// Full frame (length prefix included); returns its size
+static inline int encodeRequest(const QueryRequest& req, char* frame) {
+    char* p = putField(frame, (unsigned int)QUERY_REQUEST_SIZE);
+    p = putField(p, req.requestId);
+    p = putField(p, (unsigned char)req.type);
+    p = putField(p, req.id);
+    p = putField(p, req.k);
+    return (int)(p - frame);
+}
+
+static inline bool decodeRequest(const char* body, unsigned int length, QueryRequest& req) {
+    if (length != (unsigned int)QUERY_REQUEST_SIZE) return false;
+    unsigned char type;
+    const char* p = getField(body, req.requestId);
+    p = getField(p, type);
+    p = getField(p, req.id);
+    getField(p, req.k);
+    req.type = type;
+    return true;
+}
+
+// Full frame for up to QUERY_MAX_K rows; returns its size
+static inline int encodeResponse(unsigned int requestId, int status,
+                                 const QueryRow* rows, int count, char* frame) {
+    if (count > QUERY_MAX_K) count = QUERY_MAX_K;
+    char* p = putField(frame, (unsigned int)(QUERY_RESPONSE_HEADER + count * QUERY_ROW_SIZE));
+    p = putField(p, requestId);
+    p = putField(p, (unsigned char)status);
+    p = putField(p, count);
+    for (int i = 0; i < count; i++) {
+        p = putField(p, rows[i].id);
+        p = putField(p, rows[i].score);
+        p = putField(p, rows[i].matchedSkills);
+    }
+    return (int)(p - frame);
+}
+
+// rows must hold QUERY_MAX_K entries
+static inline bool decodeResponse(const char* body, unsigned int length, unsigned int& requestId,
+                                  int& status, QueryRow* rows, int& count) {
+    if (length < (unsigned int)QUERY_RESPONSE_HEADER) return false;
+    unsigned char st;
+    const char* p = getField(body, requestId);
+    p = getField(p, st);
+    p = getField(p, count);
+    status = st;
+    if (count < 0 || count > QUERY_MAX_K ||
+        length != (unsigned int)(QUERY_RESPONSE_HEADER + count * QUERY_ROW_SIZE)) return false;
+    for (int i = 0; i < count; i++) {
+        p = getField(p, rows[i].id);
+        p = getField(p, rows[i].score);
+        p = getField(p, rows[i].matchedSkills);
+    }
+    return true;
+}
+
+#ifndef _WIN32
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+// Blocking I/O of a whole buffer (retries short transfers and interrupts).
+// A peer that went away is an error here rather than a SIGPIPE.
+static inline bool querySendAll(int fd, const char* data, int length) {
+    while (length > 0) {
+        ssize_t n = ::send(fd, data, (size_t)length, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += n;
+        length -= (int)n;
+    }
+    return true;
+}
+
+static inline bool queryRecvAll(int fd, char* data, int length) {
+    while (length > 0) {
+        ssize_t n = ::read(fd, data, (size_t)length);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        if (n == 0) return false;
+        data += n;
+        length -= (int)n;
+    }
+    return true;
+}
+
+// Next frame body into buffer (capacity QUERY_MAX_FRAME); false on EOF or error
+static inline bool queryReadFrame(int fd, char* buffer, unsigned int& length) {
+    if (!queryRecvAll(fd, (char*)&length, sizeof(length))) return false;
+    if (length > (unsigned int)QUERY_MAX_FRAME) return false;
+    return queryRecvAll(fd, buffer, (int)length);
+}
+
+#endif
+
+} // namespace arr
+
+#endif // QUERYPROTOCOL_HPP
@@ -0,0 +1,365 @@
+// TextIndex.cpp - Inverted word index with compressed posting lists
+
+#include "TextIndex.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+namespace arr {
+
+static inline char lowerWordChar(char c) {
+    return (c >= 'A' && c <= 'Z') ? char(c + 32) : c;
+}
+
+static unsigned int hashWord(const char* word, int length) {
+    unsigned int h = 2166136261u;       // FNV-1a
+    for (int i = 0; i < length; i++) {
+        h ^= (unsigned char)word[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static inline void putVarint(std::vector<unsigned char>& out, unsigned int value) {
+    while (value >= 0x80) {
+        out.push_back((unsigned char)(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back((unsigned char)value);
+}
+
+static inline const unsigned char* getVarint(const unsigned char* p, unsigned int& value) {
+    value = 0;
+    int shift = 0;
+    while (*p & 0x80) {
+        value |= (unsigned int)(*p++ & 0x7F) << shift;
+        shift += 7;
+    }
+    value |= (unsigned int)(*p++) << shift;
+    return p;
+}
+
+// Call f(word) for every word of text, lowercased (word is the buffer used)
+template <typename F>
+static void forEachWord(const char* text, long long length, std::string& word, F f) {
+    long long i = 0;
+    while (i < length) {
+        while (i < length && !isWordChar(lowerWordChar(text[i]))) i++;
+        word.clear();
+        while (i < length && isWordChar(lowerWordChar(text[i]))) word.push_back(lowerWordChar(text[i++]));
+        if (!word.empty()) f(word);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// TextIndex
+// ---------------------------------------------------------------------------
+
+TextIndex::TextIndex()
+    : documents(0), termCount(0), terms(nullptr), docCounts(nullptr), firstBlock(nullptr),
+      blockLastDoc(nullptr), blockOffset(nullptr), postings(nullptr), postingBytes(0) {}
+
+TextIndex::~TextIndex() {
+    delete[] terms;
+    delete[] docCounts;
+    delete[] firstBlock;
+    delete[] blockLastDoc;
+    delete[] blockOffset;
+    delete[] postings;
+}
+
+long long TextIndex::sizeInBytes() const {
+    long long blocks = termCount > 0 ? firstBlock[termCount] : 0;
+    long long bytes = postingBytes + blocks * (sizeof(int) + sizeof(long long))
+                    + (long long)termCount * (sizeof(std::string) + 2 * sizeof(int));
+    for (int t = 0; t < termCount; t++) bytes += terms[t].capacity();
+    return bytes;
+}
+
+int TextIndex::findWord(const std::string& word) const {
+    int lo = 0, hi = termCount - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        int c = terms[mid].compare(word);
+        if (c == 0) return mid;
+        if (c < 0) lo = mid + 1;
+        else hi = mid - 1;
+    }
+    return -1;
+}
+
+int TextIndex::documentFrequency(const std::string& word) const {
+    int t = findWord(word);
+    return t < 0 ? 0 : docCounts[t];
+}
+
+// Walks one posting list, decoding a block at a time
+class PostingCursor {
+private:
+    const TextIndex* index;
+    int first;              // skip entries of the term: [first, end)
+    int end;
+    int block;              // decoded block
+    int docs[TextIndex::BLOCK];
+    int freqs[TextIndex::BLOCK];
+    int count;
+    int pos;
+
+    void decode(int b) {
+        block = b;
+        int base = b > first ? index->blockLastDoc[b - 1] : -1;
+        const unsigned char* p = index->postings + index->blockOffset[b];
+        count = 0;
+        int doc = base;
+        while (doc != index->blockLastDoc[b]) {
+            unsigned int delta, freq;
+            p = getVarint(p, delta);
+            p = getVarint(p, freq);
+            doc += (int)delta;
+            docs[count] = doc;
+            freqs[count] = (int)freq;
+            count++;
+        }
+        pos = 0;
+    }
+
+public:
+    int docCount;
+
+    PostingCursor(const TextIndex* index, int term)
+        : index(index), first(index->firstBlock[term]), end(index->firstBlock[term + 1]),
+          block(-1), count(0), pos(0), docCount(index->docCounts[term]) {
+        if (first < end) decode(first);
+    }
+
+    bool atEnd() const { return pos == count; }
+    int doc() const { return pos < count ? docs[pos] : INT_MAX; }
+    int freq() const { return freqs[pos]; }
+
+    void next() {
+        if (++pos == count && block + 1 < end) decode(block + 1);
+    }
+
+    // First posting with doc >= target (galloping over blocks, then within one)
+    void advanceTo(int target) {
+        if (pos == count || docs[pos] >= target) return;
+        if (index->blockLastDoc[block] < target) {
+            int lo = block + 1, step = 1, hi = lo;
+            while (hi < end && index->blockLastDoc[hi] < target) {
+                lo = hi + 1;
+                hi += step;
+                step *= 2;
+            }
+            if (hi > end) hi = end;
+            while (lo < hi) {
+                int mid = (lo + hi) / 2;
+                if (index->blockLastDoc[mid] < target) lo = mid + 1;
+                else hi = mid;
+            }
+            if (lo == end) {
+                pos = count;
+                return;
+            }
+            decode(lo);
+        }
+        int lo = pos, step = 1, hi = pos;
+        while (hi < count && docs[hi] < target) {
+            lo = hi + 1;
+            hi += step;
+            step *= 2;
+        }
+        if (hi > count) hi = count;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (docs[mid] < target) lo = mid + 1;
+            else hi = mid;
+        }
+        pos = lo;
+    }
+};
+
+// Keep hit h if it ranks among the best k (docs arrive in ascending order,
+// so an equal score never displaces an earlier document)
+static void offerHit(TextHit* best, int& size, int k, const TextHit& h) {
+    if (size == k && h.score <= best[size - 1].score) return;
+    int i = size < k ? size++ : size - 1;
+    while (i > 0 && best[i - 1].score < h.score) {
+        best[i] = best[i - 1];
+        i--;
+    }
+    best[i] = h;
+}
+
+int TextIndex::search(const std::string& query, int k, TextHit* out, int& matches) const {
+    matches = 0;
+
+    // Distinct query words; any unknown word means no document has them all
+    std::vector<int> termIds;
+    bool unknown = false;
+    std::string word;
+    forEachWord(query.data(), (long long)query.size(), word, [&](const std::string& w) {
+        int t = findWord(w);
+        if (t < 0) unknown = true;
+        else if (std::find(termIds.begin(), termIds.end(), t) == termIds.end()) termIds.push_back(t);
+    });
+    if (unknown || termIds.empty()) return 0;
+
+    std::vector<PostingCursor> cursors;
+    cursors.reserve(termIds.size());
+    for (int t : termIds) cursors.push_back(PostingCursor(this, t));
+    std::sort(cursors.begin(), cursors.end(),
+              [](const PostingCursor& a, const PostingCursor& b) { return a.docCount < b.docCount; });
+
+    int size = 0;
+    PostingCursor& lead = cursors[0];
+    while (!lead.atEnd()) {
+        int candidate = lead.doc();
+        int score = lead.freq();
+        bool all = true;
+        for (size_t c = 1; c < cursors.size(); c++) {
+            cursors[c].advanceTo(candidate);
+            if (cursors[c].doc() != candidate) {
+                // Leapfrog: the lead jumps to where this list continues
+                all = false;
+                if (cursors[c].atEnd()) return size;    // no later document has every word
+                lead.advanceTo(cursors[c].doc());
+                break;
+            }
+            score += cursors[c].freq();
+        }
+        if (!all) continue;
+
+        matches++;
+        if (k > 0) {
+            TextHit h;
+            h.doc = candidate;
+            h.score = score;
+            offerHit(out, size, k, h);
+        }
+        lead.next();
+    }
+    return size;
+}
+
+// ---------------------------------------------------------------------------
+// TextIndexBuilder
+// ---------------------------------------------------------------------------
+
+TextIndexBuilder::TextIndexBuilder() : slots(nullptr), capacity(1024), documents(0) {
+    slots = new int[capacity];
+    memset(slots, 0, sizeof(int) * capacity);
+}
+
+TextIndexBuilder::~TextIndexBuilder() {
+    delete[] slots;
+}
+
+void TextIndexBuilder::grow() {
+    int* old = slots;
+    int oldCapacity = capacity;
+    capacity *= 2;
+    slots = new int[capacity];
+    memset(slots, 0, sizeof(int) * capacity);
+    for (int i = 0; i < oldCapacity; i++) {
+        if (old[i] == 0) continue;
+        const std::string& w = postingLists[old[i] - 1].word;
+        unsigned int h = hashWord(w.data(), (int)w.size()) & (capacity - 1);
+        while (slots[h] != 0) h = (h + 1) & (capacity - 1);
+        slots[h] = old[i];
+    }
+    delete[] old;
+}
+
+// Term id of a word, added on first use
+int TextIndexBuilder::termId(const char* word, int length) {
+    unsigned int h = hashWord(word, length) & (capacity - 1);
+    while (slots[h] != 0) {
+        const std::string& w = postingLists[slots[h] - 1].word;
+        if ((int)w.size() == length && memcmp(w.data(), word, length) == 0) return slots[h] - 1;
+        h = (h + 1) & (capacity - 1);
+    }
+    postingLists.push_back(TermPostings());
+    postingLists.back().word.assign(word, length);
+    slots[h] = (int)postingLists.size();
+    if ((int)postingLists.size() * 2 > capacity) grow();
+    return (int)postingLists.size() - 1;
+}
+
+void TextIndexBuilder::addDocument(int doc, const char* text, long long length) {
+    documents++;
+    docTerms.clear();
+    std::string word;
+    forEachWord(text, length, word, [&](const std::string& w) {
+        docTerms.push_back(termId(w.data(), (int)w.size()));
+    });
+    std::sort(docTerms.begin(), docTerms.end());
+
+    for (size_t i = 0; i < docTerms.size(); ) {
+        size_t j = i;
+        while (j < docTerms.size() && docTerms[j] == docTerms[i]) j++;
+
+        TermPostings& list = postingLists[docTerms[i]];
+        if (doc > list.lastDoc) {
+            if (list.docCount % TextIndex::BLOCK == 0) {
+                list.blockOffset.push_back((long long)list.bytes.size());
+                list.blockLastDoc.push_back(doc);
+            }
+            putVarint(list.bytes, (unsigned int)(doc - list.lastDoc));
+            putVarint(list.bytes, (unsigned int)(j - i));
+            list.blockLastDoc.back() = doc;
+            list.lastDoc = doc;
+            list.docCount++;
+        }
+        i = j;
+    }
+}
+
+std::shared_ptr<const TextIndex> TextIndexBuilder::finish() {
+    TextIndex* index = new TextIndex;
+    int n = (int)postingLists.size();
+
+    std::vector<int> order(n);
+    for (int i = 0; i < n; i++) order[i] = i;
+    std::sort(order.begin(), order.end(), [this](int a, int b) {
+        return postingLists[a].word < postingLists[b].word;
+    });
+
+    long long blocks = 0, bytes = 0;
+    for (const TermPostings& list : postingLists) {
+        blocks += (long long)list.blockLastDoc.size();
+        bytes += (long long)list.bytes.size();
+    }
+
+    index->documents = documents;
+    index->termCount = n;
+    index->terms = new std::string[n > 0 ? n : 1];
+    index->docCounts = new int[n > 0 ? n : 1];
+    index->firstBlock = new int[n + 1];
+    index->blockLastDoc = new int[blocks > 0 ? blocks : 1];
+    index->blockOffset = new long long[blocks > 0 ? blocks : 1];
+    index->postings = new unsigned char[bytes > 0 ? bytes : 1];
+    index->postingBytes = bytes;
+
+    int b = 0;
+    long long offset = 0;
+    for (int t = 0; t < n; t++) {
+        TermPostings& list = postingLists[order[t]];
+        index->terms[t].swap(list.word);
+        index->docCounts[t] = list.docCount;
+        index->firstBlock[t] = b;
+        for (size_t i = 0; i < list.blockLastDoc.size(); i++, b++) {
+            index->blockLastDoc[b] = list.blockLastDoc[i];
+            index->blockOffset[b] = offset + list.blockOffset[i];
+        }
+        if (!list.bytes.empty()) memcpy(index->postings + offset, list.bytes.data(), list.bytes.size());
+        offset += (long long)list.bytes.size();
+    }
+    index->firstBlock[n] = b;
+
+    postingLists.clear();
+    memset(slots, 0, sizeof(int) * capacity);
+    documents = 0;
+    return std::shared_ptr<const TextIndex>(index);
+}
+
+} // namespace arr
@@ -0,0 +1,112 @@
+#ifndef TEXTINDEX_HPP
+#define TEXTINDEX_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+
+// Inverted word index over record text (job descriptions, resume summaries).
+//
+// Words are maximal runs of isWordChar characters after lowercasing, so
+// "C++", "c#" and "node" are words and "node.js" is two. Every word keeps a
+// posting list of (document, term frequency) pairs in ascending document
+// order. Lists are stored in blocks of BLOCK postings, each posting as a
+// varint document delta followed by a varint frequency; a skip table holds
+// the last document and byte offset of every block.
+//
+// A query is the documents containing all of its words. The rarest word's
+// list drives the intersection and the other lists are probed with
+// galloping searches, first over the skip table and then inside the one
+// block that is decoded, so long lists are mostly skipped rather than read.
+// Hits are ranked by summed term frequency.
+
+namespace arr {
+
+static inline bool isWordChar(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c=='+' || c=='#';
+}
+
+// One ranked result
+struct TextHit {
+    int doc;
+    int score;      // occurrences of the query words
+};
+
+class TextIndex {
+public:
+    static const int BLOCK = 64;
+
+private:
+    friend class TextIndexBuilder;
+    friend class PostingCursor;
+
+    int documents;
+    int termCount;
+    std::string* terms;         // sorted
+    int* docCounts;             // documents per term
+    int* firstBlock;            // first skip entry of each term
+    int* blockLastDoc;          // skip table: last document of each block
+    long long* blockOffset;     //             start of each block in postings
+    unsigned char* postings;
+    long long postingBytes;
+
+    TextIndex();
+
+public:
+    ~TextIndex();
+    TextIndex(const TextIndex&) = delete;
+    TextIndex& operator=(const TextIndex&) = delete;
+
+    int documentCount() const { return documents; }
+    int wordCount() const { return termCount; }
+    long long sizeInBytes() const;
+
+    // Term id of a (lowercase) word, or -1
+    int findWord(const std::string& word) const;
+    // Documents containing the word
+    int documentFrequency(const std::string& word) const;
+
+    // Documents containing every word of query (tokenized like the text),
+    // best first; ties go to the lower document id. Writes up to k hits and
+    // returns how many; matches receives the number of matching documents.
+    int search(const std::string& query, int k, TextHit* out, int& matches) const;
+};
+
+// Builds a TextIndex one document at a time. Document ids must be added in
+// ascending order (the loaders number records as they read them).
+class TextIndexBuilder {
+private:
+    struct TermPostings {
+        std::string word;
+        std::vector<unsigned char> bytes;
+        std::vector<int> blockLastDoc;
+        std::vector<long long> blockOffset;     // within bytes
+        int docCount = 0;
+        int lastDoc = -1;
+    };
+
+    std::vector<TermPostings> postingLists;
+    int* slots;                 // open addressing: term id + 1, 0 = empty
+    int capacity;               // always a power of two
+    int documents;
+    std::vector<int> docTerms;  // scratch: term ids of the current document
+
+    int termId(const char* word, int length);
+    void grow();
+
+public:
+    TextIndexBuilder();
+    ~TextIndexBuilder();
+    TextIndexBuilder(const TextIndexBuilder&) = delete;
+    TextIndexBuilder& operator=(const TextIndexBuilder&) = delete;
+
+    void addDocument(int doc, const char* text, long long length);
+    void addDocument(int doc, const std::string& text) { addDocument(doc, text.data(), (long long)text.size()); }
+
+    // The finished index; the builder is left empty
+    std::shared_ptr<const TextIndex> finish();
+};
+
+} // namespace arr
+
+#endif // TEXTINDEX_HPP
@@ -0,0 +1,226 @@
+﻿#ifndef LINKEDLIST_HPP
+#define LINKEDLIST_HPP
+
+#include <iostream>
+#include <memory>
+#include <utility>
+
+// Node structure for the generic singly linked list
+template <typename T>
+struct ListNode {
+    T data;
+    ListNode* next;
+
+    // Constructor (payload is built in place from the given arguments)
+    template <typename... Args>
+    explicit ListNode(Args&&... args) : data(std::forward<Args>(args)...), next(nullptr) {}
+};
+
+// Generic singly linked list with head/tail pointers.
+// T must provide getId(). Nodes are obtained from Alloc (rebound to the node
+// type), one allocation per node; emplace_back/insert(T&&) construct or move
+// the record straight into its node so loading never copies the payload.
+template <typename T, typename Alloc = std::allocator<T> >
+class LinkedList {
+public:
+    typedef ListNode<T> Node;
+
+private:
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<Node> NodeAlloc;
+    typedef std::allocator_traits<NodeAlloc> NodeTraits;
+
+    NodeAlloc nodeAlloc;
+
+protected:
+    Node* head;
+    Node* tail;
+    int size;
+
+    // Allocate a node and construct its payload in place
+    template <typename... Args>
+    Node* createNode(Args&&... args) {
+        Node* node = NodeTraits::allocate(nodeAlloc, 1);
+        try {
+            NodeTraits::construct(nodeAlloc, node, std::forward<Args>(args)...);
+        } catch (...) {
+            NodeTraits::deallocate(nodeAlloc, node, 1);
+            throw;
+        }
+        return node;
+    }
+
+    void destroyNode(Node* node) {
+        NodeTraits::destroy(nodeAlloc, node);
+        NodeTraits::deallocate(nodeAlloc, node, 1);
+    }
+
+    void linkBack(Node* newNode) {
+        if (isEmpty()) {
+            head = tail = newNode;
+        } else {
+            tail->next = newNode;
+            tail = newNode;
+        }
+        size++;
+    }
+
+    void linkFront(Node* newNode) {
+        if (isEmpty()) {
+            head = tail = newNode;
+        } else {
+            newNode->next = head;
+            head = newNode;
+        }
+        size++;
+    }
+
+    // Bubble sort on an integer key (swaps payloads, nodes stay in place)
+    template <typename KeyFn>
+    void bubbleSortBy(KeyFn key) {
+        if (size < 2) return;
+
+        bool swapped;
+        do {
+            swapped = false;
+            Node* current = head;
+
+            while (current->next != nullptr) {
+                if (key(current->data) > key(current->next->data)) {
+                    std::swap(current->data, current->next->data);
+                    swapped = true;
+                }
+                current = current->next;
+            }
+        } while (swapped);
+    }
+
+public:
+    // Constructor & Destructor
+    LinkedList() : head(nullptr), tail(nullptr), size(0) {}
+    ~LinkedList() { clear(); }
+
+    // Lists own their nodes, so they can't be copied
+    LinkedList(const LinkedList&) = delete;
+    LinkedList& operator=(const LinkedList&) = delete;
+
+    // Insert at end
+    void insert(const T& item) { linkBack(createNode(item)); }
+    void insert(T&& item) { linkBack(createNode(std::move(item))); }
+
+    // Construct a record in place at the end and return it
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        Node* newNode = createNode(std::forward<Args>(args)...);
+        linkBack(newNode);
+        return newNode->data;
+    }
+
+    // Insert at beginning
+    void insertAtBeginning(const T& item) { linkFront(createNode(item)); }
+    void insertAtBeginning(T&& item) { linkFront(createNode(std::move(item))); }
+
+    // Insert at specific position
+    void insertAtPosition(const T& item, int position) {
+        if (position < 0 || position > size) {
+            std::cout << "Invalid position!" << std::endl;
+            return;
+        }
+
+        if (position == 0) {
+            insertAtBeginning(item);
+            return;
+        }
+
+        if (position == size) {
+            insert(item);
+            return;
+        }
+
+        Node* newNode = createNode(item);
+        Node* current = head;
+
+        for (int i = 0; i < position - 1; i++) {
+            current = current->next;
+        }
+
+        newNode->next = current->next;
+        current->next = newNode;
+        size++;
+    }
+
+    // Remove by ID
+    bool remove(int id) {
+        if (isEmpty()) return false;
+
+        if (head->data.getId() == id) {
+            Node* temp = head;
+            head = head->next;
+            if (head == nullptr) tail = nullptr;
+            destroyNode(temp);
+            size--;
+            return true;
+        }
+
+        Node* current = head;
+        while (current->next != nullptr && current->next->data.getId() != id) {
+            current = current->next;
+        }
+
+        if (current->next == nullptr) return false;
+
+        Node* temp = current->next;
+        current->next = current->next->next;
+
+        if (temp == tail) tail = current;
+
+        destroyNode(temp);
+        size--;
+        return true;
+    }
+
+    // Clear all nodes
+    void clear() {
+        Node* current = head;
+        while (current != nullptr) {
+            Node* temp = current;
+            current = current->next;
+            destroyNode(temp);
+        }
+        head = tail = nullptr;
+        size = 0;
+    }
+
+    // Search by ID
+    T* search(int id) {
+        Node* current = head;
+        while (current != nullptr) {
+            if (current->data.getId() == id) {
+                return &(current->data);
+            }
+            current = current->next;
+        }
+        return nullptr;
+    }
+
+    // Get record at index
+    T* getAt(int index) {
+        if (index < 0 || index >= size) return nullptr;
+
+        Node* current = head;
+        for (int i = 0; i < index; i++) {
+            current = current->next;
+        }
+        return &(current->data);
+    }
+
+    // Sort by ID (Bubble Sort)
+    void sortById() {
+        bubbleSortBy([](const T& item) { return item.getId(); });
+    }
+
+    Node* getHead() const { return head; }
+    int getSize() const { return size; }
+    bool isEmpty() const { return head == nullptr; }
+};
+
+#endif
@@ -2,45 +2,28 @@
 #include <iostream>
 #include <iomanip>
 
+const ScoreTables<LinkedListScoringPolicy> MatchingEngine::scoreTables;
+
 // Calculate overall match score
 double MatchingEngine::calculateMatchScore(const Job& job, const Resume& resume) {
-    // Skill matching score (0-100)
     int matchingSkills = countMatchingSkills(job, resume);
-    int totalJobSkills = job.getSkillCount();
-    
-    double skillScore = 0.0;
-    if (totalJobSkills > 0) {
-        skillScore = (static_cast<double>(matchingSkills) / totalJobSkills) * 100.0;
-    }
-    
-    // Experience score (0-100)
-    double experienceScore = calculateExperienceScore(job, resume);
-    
-    // Weighted final score
-    double finalScore = (skillScore * SKILL_WEIGHT / 100.0) + 
-                        (experienceScore * EXPERIENCE_WEIGHT / 100.0);
     
-    return finalScore;
+    return scoreTables.score(matchingSkills, job.getSkillCount(), resume.getSkillCount(),
+                             job.getExperienceRequired(), resume.getYearsOfExperience());
 }
 
-// Count matching skills between job and resume
+// Weighted score from an already computed skill overlap
+double MatchingEngine::scoreFromOverlap(int matchingSkills, int totalJobSkills, double experienceScore) {
+    return scoreTables.scoreWithExperience(matchingSkills, totalJobSkills, 0, experienceScore);
+}
+
+// Count matching skills between job and resume (no string copies)
 int MatchingEngine::countMatchingSkills(const Job& job, const Resume& resume) {
-    int count = 0;
-    
-    for (int i = 0; i < job.getSkillCount(); i++) {
-        std::string jobSkill = job.getSkill(i);
-        
-        for (int j = 0; j < resume.getSkillCount(); j++) {
-            std::string resumeSkill = resume.getSkill(j);
-            
-            if (jobSkill == resumeSkill) {
-                count++;
-                break;
-            }
-        }
-    }
+    SkillView jobSkills = job.getSkills();
+    SkillView resumeSkills = resume.getSkills();
     
-    return count;
+    return LinkedListScoring::countOverlap(jobSkills.data, jobSkills.size(),
+                                           resumeSkills.data, resumeSkills.size());
 }
 
 // Check if resume meets experience requirement
@@ -50,19 +33,11 @@ bool MatchingEngine::meetsExperienceRequirement(const Job& job, const Resume& re
 
 // Calculate experience score (0-100)
 double MatchingEngine::calculateExperienceScore(const Job& job, const Resume& resume) {
-    int required = job.getExperienceRequired();
-    int actual = resume.getYearsOfExperience();
-    
-    if (required == 0) {
-        return 100.0;
-    }
-    
-    if (actual >= required) {
-        double ratio = static_cast<double>(actual) / required;
-        return (ratio >= 2.0) ? 100.0 : 50.0 + (ratio * 50.0);
-    } else {
-        return (static_cast<double>(actual) / required) * 100.0;
-    }
+    return calculateExperienceScore(job.getExperienceRequired(), resume.getYearsOfExperience());
+}
+
+double MatchingEngine::calculateExperienceScore(int required, int actual) {
+    return scoreTables.experienceScore(required, actual);
 }
 
 // Display detailed match information
@@ -94,7 +69,7 @@ void MatchingEngine::displayMatchDetails(const Job& job, const Resume& resume, d
         std::cout << "\n   Matched Skills: ";
         bool first = true;
         for (int i = 0; i < job.getSkillCount(); i++) {
-            std::string jobSkill = job.getSkill(i);
+            const std::string& jobSkill = job.getSkill(i);
             if (resume.hasSkill(jobSkill)) {
                 if (!first) std::cout << ", ";
                 std::cout << jobSkill;
@@ -4,6 +4,7 @@
 #include "../shared/Job.hpp"
 #include "../shared/Resume.hpp"
 #include "../shared/Match.hpp"
+#include "../shared/ScoringCore.hpp"
 
 // Simple array-based structure to store matches
 struct MatchArray {
@@ -30,11 +31,13 @@ struct MatchArray {
     }
 };
 
+// Linked list scoring (60% skills / 40% experience), see ScoringCore.hpp
+typedef ScoringCore<LinkedListScoringPolicy> LinkedListScoring;
+
 class MatchingEngine {
 private:
-    // Weight factors for scoring (total = 100%)
-    static const int SKILL_WEIGHT = 60;
-    static const int EXPERIENCE_WEIGHT = 40;
+    // Experience and skill score lookup tables, built once at startup
+    static const ScoreTables<LinkedListScoringPolicy> scoreTables;
     
 public:
     // Calculate match score between a job and resume
@@ -48,6 +51,11 @@ public:
     
     // Calculate experience score (0-100)
     static double calculateExperienceScore(const Job& job, const Resume& resume);
+    static double calculateExperienceScore(int required, int actual);
+    
+    // Combine a skill overlap and experience score into the final score
+    // (used by the skill indexes so their scores match calculateMatchScore)
+    static double scoreFromOverlap(int matchingSkills, int totalJobSkills, double experienceScore);
     
     // Display match details
     static void displayMatchDetails(const Job& job, const Resume& resume, double score);
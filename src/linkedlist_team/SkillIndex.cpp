@@ -0,0 +1,670 @@
+﻿#include "SkillIndex.hpp"
+
+// Candidate kept while collecting the top k results
+struct TopKCandidate {
+    double score;
+    int pos;        // position in list order (tie-breaker)
+    int matched;
+};
+
+// Fixed-size min-heap whose root is the current k-th best candidate
+struct TopKHeap {
+    TopKCandidate* items;
+    int size;
+    int capacity;
+    
+    TopKHeap(int cap) : size(0), capacity(cap) {
+        items = new TopKCandidate[capacity];
+    }
+    
+    ~TopKHeap() {
+        delete[] items;
+    }
+    
+    // a ranks below b: lower score, or same score but later in the list
+    static bool worse(const TopKCandidate& a, const TopKCandidate& b) {
+        return a.score < b.score || (a.score == b.score && a.pos > b.pos);
+    }
+    
+    bool isFull() const {
+        return size == capacity;
+    }
+    
+    double minScore() const {
+        return items[0].score;
+    }
+    
+    void push(const TopKCandidate& c) {
+        if (size < capacity) {
+            int i = size++;
+            items[i] = c;
+            while (i > 0) {
+                int parent = (i - 1) / 2;
+                if (!worse(items[i], items[parent])) break;
+                TopKCandidate t = items[i]; items[i] = items[parent]; items[parent] = t;
+                i = parent;
+            }
+        } else if (worse(items[0], c)) {
+            items[0] = c;
+            siftDown(0);
+        }
+    }
+    
+    void siftDown(int i) {
+        while (true) {
+            int l = 2 * i + 1, r = l + 1, m = i;
+            if (l < size && worse(items[l], items[m])) m = l;
+            if (r < size && worse(items[r], items[m])) m = r;
+            if (m == i) break;
+            TopKCandidate t = items[i]; items[i] = items[m]; items[m] = t;
+            i = m;
+        }
+    }
+    
+    // Empty the heap into out, best first
+    int drainBestFirst(TopKCandidate* out) {
+        int n = size;
+        for (int i = n - 1; i >= 0; i--) {
+            out[i] = items[0];
+            items[0] = items[--size];
+            siftDown(0);
+        }
+        return n;
+    }
+};
+
+// Stable merge sort of list positions by key(record)
+template <typename T, typename Key>
+static void sortPositions(int* pos, int* tmp, int lo, int hi, const T** records, Key key) {
+    if (hi - lo < 2) return;
+    int mid = (lo + hi) / 2;
+    sortPositions(pos, tmp, lo, mid, records, key);
+    sortPositions(pos, tmp, mid, hi, records, key);
+    int i = lo, j = mid, k = lo;
+    while (i < mid && j < hi) {
+        if (key(records[pos[j]]) < key(records[pos[i]])) tmp[k++] = pos[j++];
+        else tmp[k++] = pos[i++];
+    }
+    while (i < mid) tmp[k++] = pos[i++];
+    while (j < hi) tmp[k++] = pos[j++];
+    for (k = lo; k < hi; k++) pos[k] = tmp[k];
+}
+
+// Merge sort of list positions by record id
+template <typename T>
+static void sortPositionsById(int* pos, int* tmp, int lo, int hi, const T** records) {
+    sortPositions(pos, tmp, lo, hi, records, [](const T* r) { return r->getId(); });
+}
+
+// Cut members[lo, hi), sorted by years, into buckets of equal years
+static void appendYearBuckets(const int* members, int lo, int hi, const int* yearsOf,
+                              int* bucketStart, int* bucketYears, int& count) {
+    for (int m = lo; m < hi; m++) {
+        if (m == lo || yearsOf[members[m]] != yearsOf[members[m - 1]]) {
+            bucketStart[count] = m;
+            bucketYears[count] = yearsOf[members[m]];
+            count++;
+        }
+    }
+    bucketStart[count] = hi;
+}
+
+// Add a years value to the set
+void SkillIndex::YearSet::add(int years) {
+    for (int i = 0; i < count; i++) {
+        if (values[i] == years) return;
+    }
+    if (count < MAX_VALUES) values[count++] = years;
+    else overflow = true;
+}
+
+// Highest experience score reachable for a requirement against any years in the set
+static double maxExperienceScoreFor(int required, const int* actual, int count, bool overflow) {
+    if (overflow) return 100.0;
+    
+    double best = 0.0;
+    for (int i = 0; i < count; i++) {
+        double s = MatchingEngine::calculateExperienceScore(required, actual[i]);
+        if (s > best) best = s;
+    }
+    return best;
+}
+
+// Highest experience score reachable for a resume against any requirement in the set
+static double maxExperienceScoreAgainst(int actual, const int* required, int count, bool overflow) {
+    if (overflow) return 100.0;
+    
+    double best = 0.0;
+    for (int i = 0; i < count; i++) {
+        double s = MatchingEngine::calculateExperienceScore(required[i], actual);
+        if (s > best) best = s;
+    }
+    return best;
+}
+
+// Constructor
+SkillIndex::SkillIndex()
+    : skillTotal(0), skillOverflow(false),
+      jobs(nullptr), jobsById(nullptr), jobCount(0), jobPostings(nullptr), groupMembers(nullptr),
+      resumes(nullptr), resumesById(nullptr), resumeCount(0), resumePostings(nullptr),
+      resumesByYears(nullptr),
+      overlap(nullptr), touched(nullptr), ordered(nullptr),
+      jobOverlap(nullptr), jobTouched(nullptr), jobOrdered(nullptr),
+      bucketScore(nullptr), bucketOrder(nullptr) {
+    clear();
+}
+
+// Destructor
+SkillIndex::~SkillIndex() {
+    clear();
+}
+
+// Release everything
+void SkillIndex::clear() {
+    delete[] jobs;
+    delete[] jobsById;
+    delete[] jobPostings;
+    delete[] groupMembers;
+    delete[] jobBuckets.start;
+    delete[] jobBuckets.years;
+    delete[] resumes;
+    delete[] resumesById;
+    delete[] resumePostings;
+    delete[] resumesByYears;
+    delete[] resumeBuckets.start;
+    delete[] resumeBuckets.years;
+    delete[] overlap;
+    delete[] touched;
+    delete[] ordered;
+    delete[] jobOverlap;
+    delete[] jobTouched;
+    delete[] jobOrdered;
+    delete[] bucketScore;
+    delete[] bucketOrder;
+    
+    jobs = nullptr;
+    jobsById = nullptr;
+    jobPostings = nullptr;
+    groupMembers = nullptr;
+    jobBuckets = YearBuckets();
+    resumes = nullptr;
+    resumesById = nullptr;
+    resumePostings = nullptr;
+    resumesByYears = nullptr;
+    resumeBuckets = YearBuckets();
+    overlap = nullptr;
+    touched = nullptr;
+    ordered = nullptr;
+    jobOverlap = nullptr;
+    jobTouched = nullptr;
+    jobOrdered = nullptr;
+    bucketScore = nullptr;
+    bucketOrder = nullptr;
+    
+    jobCount = resumeCount = 0;
+    skillTotal = 0;
+    skillOverflow = false;
+    for (int i = 0; i <= MAX_SKILLS; i++) {
+        jobPostingStart[i] = 0;
+        resumePostingStart[i] = 0;
+    }
+    for (int i = 0; i <= MAX_JOB_SKILLS + 1; i++) groupStart[i] = groupBucketStart[i] = 0;
+    for (int i = 0; i <= MAX_JOB_SKILLS; i++) groupYears[i] = YearSet();
+    resumeYears = YearSet();
+}
+
+bool SkillIndex::isBuilt() const {
+    return jobs != nullptr && resumes != nullptr;
+}
+
+// Skill name -> id (-1 if unknown)
+int SkillIndex::findSkill(const std::string& skill) const {
+    for (int i = 0; i < skillTotal; i++) {
+        if (skillNames[i] == skill) return i;
+    }
+    return -1;
+}
+
+// Skill name -> id, adding it to the dictionary if needed
+int SkillIndex::addSkillName(const std::string& skill) {
+    int id = findSkill(skill);
+    if (id >= 0) return id;
+    if (skillTotal == MAX_SKILLS) {
+        skillOverflow = true;
+        return -1;
+    }
+    skillNames[skillTotal] = skill;
+    return skillTotal++;
+}
+
+// Build the index from both lists
+void SkillIndex::build(const JobLinkedList& jobList, const ResumeLinkedList& resumeList) {
+    clear();
+    buildJobSide(jobList);
+    buildResumeSide(resumeList);
+    buildBucketScratch();
+}
+
+// Jobs: id lookup, posting lists and skill-count groups
+void SkillIndex::buildJobSide(const JobLinkedList& jobList) {
+    jobCount = jobList.getSize();
+    int cap = jobCount > 0 ? jobCount : 1;
+    jobs = new const Job*[cap];
+    jobsById = new int[cap];
+    
+    // First pass: collect jobs, assign skill ids, count list lengths
+    int counts[MAX_SKILLS] = {0};
+    int groupCounts[MAX_JOB_SKILLS + 1] = {0};
+    int n = 0;
+    for (JobNode* cur = jobList.getHead(); cur != nullptr; cur = cur->next) {
+        const Job& j = cur->data;
+        for (int i = 0; i < j.getSkillCount(); i++) {
+            int id = addSkillName(j.getSkill(i));
+            if (id >= 0) counts[id]++;
+        }
+        groupCounts[j.getSkillCount()]++;
+        groupYears[j.getSkillCount()].add(j.getExperienceRequired());
+        jobs[n] = &j;
+        jobsById[n] = n;
+        n++;
+    }
+    
+    int* tmp = new int[cap];
+    sortPositionsById(jobsById, tmp, 0, jobCount, jobs);
+    delete[] tmp;
+    
+    // Second pass: fill posting lists and groups (positions come out ascending)
+    jobPostingStart[0] = 0;
+    for (int s = 0; s < MAX_SKILLS; s++) {
+        jobPostingStart[s + 1] = jobPostingStart[s] + counts[s];
+    }
+    groupStart[0] = 0;
+    for (int g = 0; g <= MAX_JOB_SKILLS; g++) {
+        groupStart[g + 1] = groupStart[g] + groupCounts[g];
+    }
+    jobPostings = new int[jobPostingStart[MAX_SKILLS] > 0 ? jobPostingStart[MAX_SKILLS] : 1];
+    groupMembers = new int[cap];
+    
+    int fill[MAX_SKILLS];
+    for (int s = 0; s < MAX_SKILLS; s++) fill[s] = jobPostingStart[s];
+    int groupFill[MAX_JOB_SKILLS + 1];
+    for (int g = 0; g <= MAX_JOB_SKILLS; g++) groupFill[g] = groupStart[g];
+    
+    for (int p = 0; p < jobCount; p++) {
+        const Job& j = *jobs[p];
+        // A skill listed twice counts twice in countMatchingSkills, so keep duplicates
+        for (int i = 0; i < j.getSkillCount(); i++) {
+            int id = findSkill(j.getSkill(i));
+            if (id >= 0) jobPostings[fill[id]++] = p;
+        }
+        groupMembers[groupFill[j.getSkillCount()]++] = p;
+    }
+    
+    // Each group bucketed by required years, ascending within a bucket
+    int* years = new int[cap];
+    for (int p = 0; p < jobCount; p++) years[p] = jobs[p]->getExperienceRequired();
+    tmp = new int[cap];
+    jobBuckets.start = new int[cap + 1];
+    jobBuckets.years = new int[cap];
+    for (int g = 0; g <= MAX_JOB_SKILLS; g++) {
+        sortPositions(groupMembers, tmp, groupStart[g], groupStart[g + 1], jobs,
+                      [](const Job* j) { return j->getExperienceRequired(); });
+        groupBucketStart[g] = jobBuckets.count;
+        appendYearBuckets(groupMembers, groupStart[g], groupStart[g + 1], years,
+                          jobBuckets.start, jobBuckets.years, jobBuckets.count);
+    }
+    groupBucketStart[MAX_JOB_SKILLS + 1] = jobBuckets.count;
+    delete[] tmp;
+    delete[] years;
+    
+    jobOverlap = new unsigned char[cap];
+    jobTouched = new int[cap];
+    jobOrdered = new int[cap];
+    for (int p = 0; p < cap; p++) jobOverlap[p] = 0;
+}
+
+// Resumes: id lookup and posting lists
+void SkillIndex::buildResumeSide(const ResumeLinkedList& resumeList) {
+    resumeCount = resumeList.getSize();
+    int cap = resumeCount > 0 ? resumeCount : 1;
+    resumes = new const Resume*[cap];
+    resumesById = new int[cap];
+    unsigned long long* masks = new unsigned long long[cap];
+    int counts[MAX_SKILLS] = {0};
+    
+    // First pass: assign skill ids and count posting lengths
+    int n = 0;
+    for (ResumeNode* cur = resumeList.getHead(); cur != nullptr; cur = cur->next) {
+        const Resume& r = cur->data;
+        unsigned long long mask = 0;
+        for (int i = 0; i < r.getSkillCount(); i++) {
+            int id = addSkillName(r.getSkill(i));
+            if (id < 0) continue;
+            unsigned long long bit = 1ULL << id;
+            if (!(mask & bit)) {
+                mask |= bit;
+                counts[id]++;
+            }
+        }
+        resumeYears.add(r.getYearsOfExperience());
+        resumes[n] = &r;
+        resumesById[n] = n;
+        masks[n] = mask;
+        n++;
+    }
+    
+    int* tmp = new int[cap];
+    sortPositionsById(resumesById, tmp, 0, resumeCount, resumes);
+    delete[] tmp;
+    
+    // Second pass fills the posting lists (positions come out ascending)
+    resumePostingStart[0] = 0;
+    for (int s = 0; s < MAX_SKILLS; s++) {
+        resumePostingStart[s + 1] = resumePostingStart[s] + counts[s];
+    }
+    resumePostings = new int[resumePostingStart[MAX_SKILLS] > 0 ? resumePostingStart[MAX_SKILLS] : 1];
+    int fill[MAX_SKILLS];
+    for (int s = 0; s < MAX_SKILLS; s++) fill[s] = resumePostingStart[s];
+    
+    for (int p = 0; p < resumeCount; p++) {
+        unsigned long long mask = masks[p];
+        while (mask) {
+            int s = __builtin_ctzll(mask);
+            resumePostings[fill[s]++] = p;
+            mask &= mask - 1;
+        }
+    }
+    delete[] masks;
+    
+    // Positions bucketed by years of experience, ascending within a bucket
+    int* years = new int[cap];
+    resumesByYears = new int[cap];
+    for (int p = 0; p < resumeCount; p++) {
+        years[p] = resumes[p]->getYearsOfExperience();
+        resumesByYears[p] = p;
+    }
+    tmp = new int[cap];
+    sortPositions(resumesByYears, tmp, 0, resumeCount, resumes,
+                  [](const Resume* r) { return r->getYearsOfExperience(); });
+    delete[] tmp;
+    resumeBuckets.start = new int[cap + 1];
+    resumeBuckets.years = new int[cap];
+    appendYearBuckets(resumesByYears, 0, resumeCount, years,
+                      resumeBuckets.start, resumeBuckets.years, resumeBuckets.count);
+    delete[] years;
+    
+    overlap = new unsigned char[cap];
+    touched = new int[cap];
+    ordered = new int[cap];
+    for (int p = 0; p < cap; p++) overlap[p] = 0;
+}
+
+// Scratch for ranking year buckets, sized for the larger side
+void SkillIndex::buildBucketScratch() {
+    int cap = jobBuckets.count > resumeBuckets.count ? jobBuckets.count : resumeBuckets.count;
+    if (cap == 0) cap = 1;
+    bucketScore = new double[cap];
+    bucketOrder = new int[cap];
+}
+
+// Zero-overlap candidates from buckets [first, last), whose scores the caller
+// put in bucketScore. Buckets are visited best score first; members of a
+// bucket tie on score and ascend by position, so a bucket is left at its
+// first member the heap turns away, and the scan ends at the first bucket
+// that can't beat the k-th best.
+void SkillIndex::pushZeroOverlap(TopKHeap& heap, const int* members, const YearBuckets& buckets,
+                                 int first, int last, const unsigned char* overlapOf) {
+    int n = 0;
+    for (int b = first; b < last; b++) {
+        int i = n++;
+        while (i > 0 && bucketScore[bucketOrder[i - 1]] < bucketScore[b]) {
+            bucketOrder[i] = bucketOrder[i - 1];
+            i--;
+        }
+        bucketOrder[i] = b;
+    }
+    
+    for (int i = 0; i < n; i++) {
+        int b = bucketOrder[i];
+        if (heap.isFull() && heap.minScore() > bucketScore[b]) break;
+        
+        for (int m = buckets.start[b]; m < buckets.start[b + 1]; m++) {
+            int p = members[m];
+            if (overlapOf[p] != 0) continue;
+            TopKCandidate c;
+            c.matched = 0;
+            c.score = bucketScore[b];
+            c.pos = p;
+            if (heap.isFull() && !TopKHeap::worse(heap.items[0], c)) break;
+            heap.push(c);
+        }
+    }
+}
+
+// Binary search over the id-sorted job positions
+const Job* SkillIndex::findJob(int jobId) const {
+    int lo = 0, hi = jobCount - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        int id = jobs[jobsById[mid]]->getId();
+        if (id == jobId) return jobs[jobsById[mid]];
+        if (id < jobId) lo = mid + 1;
+        else hi = mid - 1;
+    }
+    return nullptr;
+}
+
+// Binary search over the id-sorted resume positions
+const Resume* SkillIndex::findResume(int resumeId) const {
+    int lo = 0, hi = resumeCount - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        int id = resumes[resumesById[mid]]->getId();
+        if (id == resumeId) return resumes[resumesById[mid]];
+        if (id < resumeId) lo = mid + 1;
+        else hi = mid - 1;
+    }
+    return nullptr;
+}
+
+// Top k candidates for a job
+int SkillIndex::topCandidatesForJob(int jobId, int k, MatchArray& out) {
+    const Job* job = findJob(jobId);
+    if (job == nullptr) return -1;
+    if (k <= 0 || resumeCount == 0) return 0;
+    if (k > resumeCount) k = resumeCount;
+    
+    TopKHeap heap(k);
+    int required = job->getExperienceRequired();
+    int totalJobSkills = job->getSkillCount();
+    
+    if (skillOverflow) {
+        // Dictionary is incomplete, so posting lists can't be trusted: score everything
+        for (int p = 0; p < resumeCount; p++) {
+            TopKCandidate c;
+            c.matched = MatchingEngine::countMatchingSkills(*job, *resumes[p]);
+            c.score = MatchingEngine::scoreFromOverlap(c.matched, totalJobSkills,
+                          MatchingEngine::calculateExperienceScore(required, resumes[p]->getYearsOfExperience()));
+            c.pos = p;
+            heap.push(c);
+        }
+    } else {
+        // Accumulate overlaps from the posting lists of the job's skills
+        int touchedCount = 0;
+        for (int i = 0; i < totalJobSkills; i++) {
+            int s = findSkill(job->getSkill(i));
+            if (s < 0) continue;
+            for (int j = resumePostingStart[s]; j < resumePostingStart[s + 1]; j++) {
+                int p = resumePostings[j];
+                if (overlap[p] == 0) touched[touchedCount++] = p;
+                overlap[p]++;
+            }
+        }
+        
+        // Group touched resumes by overlap (counting sort, highest first)
+        int levelStart[MAX_JOB_SKILLS + 2] = {0};
+        for (int t = 0; t < touchedCount; t++) levelStart[totalJobSkills - overlap[touched[t]] + 1]++;
+        for (int o = 1; o <= totalJobSkills + 1; o++) levelStart[o] += levelStart[o - 1];
+        int fill[MAX_JOB_SKILLS + 1];
+        for (int o = 0; o <= totalJobSkills; o++) fill[o] = levelStart[o];
+        for (int t = 0; t < touchedCount; t++) {
+            int p = touched[t];
+            ordered[fill[totalJobSkills - overlap[p]]++] = p;
+        }
+        
+        // Score level by level, stopping once the bound can't beat the k-th best
+        double maxExp = maxExperienceScoreFor(required, resumeYears.values, resumeYears.count,
+                                              resumeYears.overflow);
+        for (int o = totalJobSkills; o >= 0; o--) {
+            double bound = MatchingEngine::scoreFromOverlap(o, totalJobSkills, maxExp);
+            if (heap.isFull() && heap.minScore() > bound) break;
+            
+            if (o > 0) {
+                int level = totalJobSkills - o;
+                for (int t = levelStart[level]; t < levelStart[level + 1]; t++) {
+                    int p = ordered[t];
+                    TopKCandidate c;
+                    c.matched = o;
+                    c.score = MatchingEngine::scoreFromOverlap(o, totalJobSkills,
+                                  MatchingEngine::calculateExperienceScore(required, resumes[p]->getYearsOfExperience()));
+                    c.pos = p;
+                    heap.push(c);
+                }
+            } else {
+                // Resumes sharing no skill with the job, best experience buckets first
+                for (int b = 0; b < resumeBuckets.count; b++) {
+                    bucketScore[b] = MatchingEngine::scoreFromOverlap(0, totalJobSkills,
+                                         MatchingEngine::calculateExperienceScore(required, resumeBuckets.years[b]));
+                }
+                pushZeroOverlap(heap, resumesByYears, resumeBuckets, 0, resumeBuckets.count, overlap);
+            }
+        }
+        
+        // Reset scratch counters for the next query
+        for (int t = 0; t < touchedCount; t++) overlap[touched[t]] = 0;
+    }
+    
+    TopKCandidate* best = new TopKCandidate[k];
+    int found = heap.drainBestFirst(best);
+    for (int i = 0; i < found; i++) {
+        out.add(Match(job->getId(), resumes[best[i].pos]->getId(), best[i].score, best[i].matched));
+    }
+    delete[] best;
+    return found;
+}
+
+// Top k jobs for a resume
+int SkillIndex::topJobsForResume(int resumeId, int k, MatchArray& out) {
+    const Resume* resume = findResume(resumeId);
+    if (resume == nullptr) return -1;
+    if (k <= 0 || jobCount == 0) return 0;
+    if (k > jobCount) k = jobCount;
+    
+    TopKHeap heap(k);
+    int actual = resume->getYearsOfExperience();
+    
+    if (skillOverflow) {
+        for (int p = 0; p < jobCount; p++) {
+            TopKCandidate c;
+            c.matched = MatchingEngine::countMatchingSkills(*jobs[p], *resume);
+            c.score = MatchingEngine::scoreFromOverlap(c.matched, jobs[p]->getSkillCount(),
+                          MatchingEngine::calculateExperienceScore(jobs[p]->getExperienceRequired(), actual));
+            c.pos = p;
+            heap.push(c);
+        }
+    } else {
+        // Accumulate overlaps from the posting lists of the resume's (distinct) skills
+        unsigned long long seen = 0;
+        int touchedCount = 0;
+        for (int i = 0; i < resume->getSkillCount(); i++) {
+            int s = findSkill(resume->getSkill(i));
+            if (s < 0 || (seen & (1ULL << s))) continue;
+            seen |= 1ULL << s;
+            for (int j = jobPostingStart[s]; j < jobPostingStart[s + 1]; j++) {
+                int p = jobPostings[j];
+                if (jobOverlap[p] == 0) jobTouched[touchedCount++] = p;
+                jobOverlap[p]++;
+            }
+        }
+        
+        // Bucket touched jobs by (skill count, overlap) and note each group's best overlap
+        const int LEVELS = MAX_JOB_SKILLS + 1;
+        int bucketStart[LEVELS * LEVELS + 1] = {0};
+        int maxOverlap[LEVELS] = {0};
+        for (int t = 0; t < touchedCount; t++) {
+            int p = jobTouched[t];
+            int g = jobs[p]->getSkillCount();
+            int o = jobOverlap[p];
+            bucketStart[g * LEVELS + o + 1]++;
+            if (o > maxOverlap[g]) maxOverlap[g] = o;
+        }
+        for (int b = 1; b <= LEVELS * LEVELS; b++) bucketStart[b] += bucketStart[b - 1];
+        int fill[LEVELS * LEVELS];
+        for (int b = 0; b < LEVELS * LEVELS; b++) fill[b] = bucketStart[b];
+        for (int t = 0; t < touchedCount; t++) {
+            int p = jobTouched[t];
+            jobOrdered[fill[jobs[p]->getSkillCount() * LEVELS + jobOverlap[p]]++] = p;
+        }
+        
+        // Visit groups in order of decreasing upper bound
+        double groupExp[LEVELS];
+        double groupBound[LEVELS];
+        int groupOrder[LEVELS];
+        int groups = 0;
+        for (int g = 0; g < LEVELS; g++) {
+            if (groupStart[g + 1] == groupStart[g]) continue;
+            groupExp[g] = maxExperienceScoreAgainst(actual, groupYears[g].values, groupYears[g].count,
+                                                    groupYears[g].overflow);
+            groupBound[g] = MatchingEngine::scoreFromOverlap(maxOverlap[g], g, groupExp[g]);
+            int i = groups++;
+            while (i > 0 && groupBound[groupOrder[i - 1]] < groupBound[g]) {
+                groupOrder[i] = groupOrder[i - 1];
+                i--;
+            }
+            groupOrder[i] = g;
+        }
+        
+        for (int gi = 0; gi < groups; gi++) {
+            int g = groupOrder[gi];
+            
+            // Skip the whole group once its bound can't beat the k-th best
+            if (heap.isFull() && heap.minScore() > groupBound[g]) continue;
+            
+            for (int o = maxOverlap[g]; o >= 0; o--) {
+                double bound = MatchingEngine::scoreFromOverlap(o, g, groupExp[g]);
+                if (heap.isFull() && heap.minScore() > bound) break;
+                
+                if (o > 0) {
+                    int b = g * LEVELS + o;
+                    for (int t = bucketStart[b]; t < bucketStart[b + 1]; t++) {
+                        int p = jobOrdered[t];
+                        TopKCandidate c;
+                        c.matched = o;
+                        c.score = MatchingEngine::scoreFromOverlap(o, g,
+                                      MatchingEngine::calculateExperienceScore(jobs[p]->getExperienceRequired(), actual));
+                        c.pos = p;
+                        heap.push(c);
+                    }
+                } else {
+                    // Jobs in this group sharing no skill with the resume, best experience buckets first
+                    for (int b = groupBucketStart[g]; b < groupBucketStart[g + 1]; b++) {
+                        bucketScore[b] = MatchingEngine::scoreFromOverlap(0, g,
+                                             MatchingEngine::calculateExperienceScore(jobBuckets.years[b], actual));
+                    }
+                    pushZeroOverlap(heap, groupMembers, jobBuckets, groupBucketStart[g],
+                                    groupBucketStart[g + 1], jobOverlap);
+                }
+            }
+        }
+        
+        for (int t = 0; t < touchedCount; t++) jobOverlap[jobTouched[t]] = 0;
+    }
+    
+    TopKCandidate* best = new TopKCandidate[k];
+    int found = heap.drainBestFirst(best);
+    for (int i = 0; i < found; i++) {
+        out.add(Match(jobs[best[i].pos]->getId(), resume->getId(), best[i].score, best[i].matched));
+    }
+    delete[] best;
+    return found;
+}
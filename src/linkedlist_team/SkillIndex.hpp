@@ -0,0 +1,119 @@
+﻿#ifndef SKILLINDEX_HPP
+#define SKILLINDEX_HPP
+
+#include "JobLinkedList.hpp"
+#include "ResumeLinkedList.hpp"
+#include "MatchingEngine.hpp"
+
+// Inverted skill indexes used for interactive top-K queries.
+// Skills are mapped to small integer ids and every skill keeps a posting
+// list of the resumes (and jobs) that have it, so a query only touches the
+// records that share at least one skill with it. Candidates are scored in
+// order of decreasing overlap and the scan stops as soon as the best score
+// still reachable cannot beat the current k-th result.
+// Jobs are also grouped by skill count: the skill score of a job depends on
+// its own skill count, so each group gets its own (much tighter) bound and
+// whole groups are skipped at once.
+// Records sharing no skill with the query score by experience alone, so
+// each side is also bucketed by years (jobs within their skill-count group):
+// that level is filled from the buckets with the best experience score down
+// and stops after k, instead of scoring every record.
+// Scores are identical to MatchingEngine::calculateMatchScore.
+struct TopKHeap;
+
+class SkillIndex {
+public:
+    static const int MAX_SKILLS = 64;
+    static const int MAX_JOB_SKILLS = 10;   // Job stores at most 10 skills
+
+private:
+    // Skill dictionary (id -> name)
+    std::string skillNames[MAX_SKILLS];
+    int skillTotal;
+    bool skillOverflow;         // more than MAX_SKILLS distinct skills seen
+    
+    // Distinct years of experience in a set of records (for score upper bounds)
+    struct YearSet {
+        static const int MAX_VALUES = 64;
+        int values[MAX_VALUES];
+        int count;
+        bool overflow;
+        
+        YearSet() : count(0), overflow(false) {}
+        void add(int years);
+    };
+    
+    // Runs of positions with the same years value (CSR over a member array)
+    struct YearBuckets {
+        int* start;             // bucket -> first member (count + 1 entries)
+        int* years;
+        int count;
+        
+        YearBuckets() : start(nullptr), years(nullptr), count(0) {}
+    };
+    
+    // Job side: jobs in list order, positions sorted by id, CSR posting
+    // lists per skill and job positions grouped by skill count
+    const Job** jobs;
+    int* jobsById;
+    int jobCount;
+    int jobPostingStart[MAX_SKILLS + 1];
+    int* jobPostings;           // job positions (once per skill occurrence)
+    int groupStart[MAX_JOB_SKILLS + 2];
+    int* groupMembers;          // job positions by skill count, then required years, then position
+    YearSet groupYears[MAX_JOB_SKILLS + 1];
+    YearBuckets jobBuckets;     // over groupMembers
+    int groupBucketStart[MAX_JOB_SKILLS + 2];
+    
+    // Resume side: same layout without grouping
+    const Resume** resumes;
+    int* resumesById;
+    int resumeCount;
+    int resumePostingStart[MAX_SKILLS + 1];
+    int* resumePostings;        // resume positions
+    YearSet resumeYears;
+    int* resumesByYears;        // resume positions by years, then position
+    YearBuckets resumeBuckets;  // over resumesByYears
+    
+    // Per-query scratch space
+    unsigned char* overlap;     // overlap count per resume position
+    int* touched;               // positions with overlap > 0
+    int* ordered;               // touched positions grouped by overlap
+    unsigned char* jobOverlap;  // same, per job position
+    int* jobTouched;
+    int* jobOrdered;
+    double* bucketScore;        // zero-overlap score per year bucket
+    int* bucketOrder;           // buckets, best score first
+    
+    int findSkill(const std::string& skill) const;
+    int addSkillName(const std::string& skill);
+    void buildJobSide(const JobLinkedList& jobList);
+    void buildResumeSide(const ResumeLinkedList& resumeList);
+    void buildBucketScratch();
+    void pushZeroOverlap(TopKHeap& heap, const int* members, const YearBuckets& buckets,
+                         int first, int last, const unsigned char* overlapOf);
+
+public:
+    // Constructor & Destructor
+    SkillIndex();
+    ~SkillIndex();
+    
+    // Build the index (rebuild after either list is modified or sorted)
+    void build(const JobLinkedList& jobList, const ResumeLinkedList& resumeList);
+    void clear();
+    bool isBuilt() const;
+    
+    // Lookup by ID (binary search)
+    const Job* findJob(int jobId) const;
+    const Resume* findResume(int resumeId) const;
+    
+    // Best k resumes for a job, best first (ties: earlier resume in the list)
+    // Returns the number of matches written to out, or -1 if the job is unknown
+    int topCandidatesForJob(int jobId, int k, MatchArray& out);
+    
+    // Best k jobs for a resume, best first (ties: earlier job in the list)
+    // Returns the number of matches written to out, or -1 if the resume is unknown
+    int topJobsForResume(int resumeId, int k, MatchArray& out);
+};
+
+#endif
@@ -11,21 +11,40 @@
 #include "linkedlist_team/JobLinkedList.hpp"
 #include "linkedlist_team/ResumeLinkedList.hpp"
 #include "linkedlist_team/MatchingEngine.hpp"
+#include "linkedlist_team/SkillIndex.hpp"
+#include "shared/Snapshot.hpp"
+#include "shared/SkillQuery.hpp"
+#include "shared/TrigramIndex.hpp"
+#include "shared/AllocTracker.hpp"
+#include "shared/PerfCounters.hpp"
+#include "shared/Tracer.hpp"
 
 using namespace std;
 using namespace chrono;
 
 // Function prototypes
 void runLinkedListImplementation();
-void loadJobsFromCSV_LL(const char* filename, JobLinkedList& jobList);
-void loadResumesFromCSV_LL(const char* filename, ResumeLinkedList& resumeList);
-void extractSkills(const string& text, Job* job, Resume* resume);
+void loadJobsFromCSV_LL(const char* filename, JobLinkedList& jobList, TrigramIndex& titleIndex);
+void loadResumesFromCSV_LL(const char* filename, ResumeLinkedList& resumeList, TrigramIndex& nameIndex);
+bool loadJobsFromSnapshot_LL(const char* filename, unsigned long long sourceKey, JobLinkedList& jobList,
+                             TrigramIndex& titleIndex);
+bool loadResumesFromSnapshot_LL(const char* filename, unsigned long long sourceKey, ResumeLinkedList& resumeList,
+                                TrigramIndex& nameIndex);
+unsigned long long extractSkills(const string& text, Job* job, Resume* resume);
 void performMatching_LL(JobLinkedList& jobList, ResumeLinkedList& resumeList, MatchArray& matches);
 void displayTopMatches_LL(const MatchArray& matches, int top, JobLinkedList& jobList, ResumeLinkedList& resumeList);
+void buildSkillQueries_LL(const JobLinkedList& jobList, const ResumeLinkedList& resumeList,
+                          SkillQueryIndex& jobQuery, SkillQueryIndex& resumeQuery);
+void runSkillQuery_LL(JobLinkedList& jobList, ResumeLinkedList& resumeList,
+                      const SkillQueryIndex& jobQuery, const SkillQueryIndex& resumeQuery);
+void runFuzzySearch_LL(JobLinkedList& jobList, ResumeLinkedList& resumeList,
+                       const TrigramIndex& titleIndex, const TrigramIndex& nameIndex);
 void displayMenu_LL();
 void displayPerformanceMetrics_LL(long long loadTime, int dataSize);
 void displayMainMenu();
 void comparePerformance(ArrayPerf arrayPerf, long long llLoadTime, long long llMatchTime, int llJobs, int llResumes);
+void compareMemory(const ArrayPerf& arrayPerf, int llJobs, int llResumes);
+void compareCounters(const ArrayPerf& arrayPerf);
 
 // Common tech skills to look for
 const string COMMON_SKILLS[] = {
@@ -48,6 +67,8 @@ long long g_llLoadTime = 0;
 long long g_llMatchTime = 0;
 int g_llJobs = 0;
 int g_llResumes = 0;
+PhaseMemory g_llJobsMemory, g_llResumesMemory, g_llMatchMemory;
+PhaseCounters g_llCounters;     // skill extraction happens inside the load phase
 
 int main() {
     cout << "\n===============================================" << endl;
@@ -132,12 +153,26 @@ void runLinkedListImplementation() {
     JobLinkedList jobList;
     ResumeLinkedList resumeList;
     MatchArray matches(10000);
+    SkillIndex skillIndex;
+    SkillQueryIndex jobQuery, resumeQuery;     // built on first use; ids and skills never change
+    bool skillQueriesBuilt = false;
+    TrigramIndex titleIndex, nameIndex;        // built while loading
     
     auto startLoad = high_resolution_clock::now();
     
     cout << "Loading data from CSV files..." << endl;
-    loadJobsFromCSV_LL("data/job_description.csv", jobList);
-    loadResumesFromCSV_LL("data/resume.csv", resumeList);
+    CounterPhase loadCounters;
+    traceBegin("load (linked list)", "load");
+    MemoryPhase jobsPhase;
+    loadJobsFromCSV_LL("data/job_description.csv", jobList, titleIndex);
+    titleIndex.finish();
+    g_llJobsMemory = jobsPhase.finish();
+    MemoryPhase resumesPhase;
+    loadResumesFromCSV_LL("data/resume.csv", resumeList, nameIndex);
+    nameIndex.finish();
+    g_llResumesMemory = resumesPhase.finish();
+    g_llCounters.phases[PHASE_LOAD] = loadCounters.finish();
+    traceEnd("load (linked list)", "load");
     
     auto endLoad = high_resolution_clock::now();
     g_llLoadTime = duration_cast<microseconds>(endLoad - startLoad).count();
@@ -212,9 +247,12 @@ void runLinkedListImplementation() {
             
             case 5: {
                 cout << "\nSorting jobs by ID..." << endl;
+                CounterPhase sortCounters;
                 auto startSort = high_resolution_clock::now();
                 jobList.sortById();
                 auto endSort = high_resolution_clock::now();
+                g_llCounters.phases[PHASE_SORT] = sortCounters.finish();
+                skillIndex.clear();  // sorting swaps node data, index must be rebuilt
                 long long sortTime = duration_cast<microseconds>(endSort - startSort).count();
                 
                 cout << "Jobs sorted successfully!" << endl;
@@ -224,9 +262,12 @@ void runLinkedListImplementation() {
             
             case 6: {
                 cout << "\nSorting resumes by experience..." << endl;
+                CounterPhase sortCounters;
                 auto startSort = high_resolution_clock::now();
                 resumeList.sortByExperience();
                 auto endSort = high_resolution_clock::now();
+                g_llCounters.phases[PHASE_SORT] = sortCounters.finish();
+                skillIndex.clear();  // sorting swaps node data, index must be rebuilt
                 long long sortTime = duration_cast<microseconds>(endSort - startSort).count();
                 
                 cout << "Resumes sorted successfully!" << endl;
@@ -239,9 +280,15 @@ void runLinkedListImplementation() {
                 cout << "This will compare " << g_llResumes << " resumes with " << g_llJobs << " jobs...\n" << endl;
                 matches.clear();
                 
+                MemoryPhase matchPhase;
+                CounterPhase matchCounters;
+                traceBegin("match (linked list)", "match");
                 auto startMatch = high_resolution_clock::now();
                 performMatching_LL(jobList, resumeList, matches);
                 auto endMatch = high_resolution_clock::now();
+                traceEnd("match (linked list)", "match");
+                g_llCounters.phases[PHASE_MATCH] = matchCounters.finish();
+                g_llMatchMemory = matchPhase.finish();
                 g_llMatchTime = duration_cast<microseconds>(endMatch - startMatch).count();
                 
                 cout << "\nMatching complete!" << endl;
@@ -288,17 +335,23 @@ void runLinkedListImplementation() {
                 cout << "\nMatching job with all candidates..." << endl;
                 job->displayDetailed();
                 
-                MatchArray specificMatches(resumeList.getSize());
-                ResumeNode* current = resumeList.getHead();
-                
-                while (current != nullptr) {
-                    double score = MatchingEngine::calculateMatchScore(*job, current->data);
-                    int skillCount = MatchingEngine::countMatchingSkills(*job, current->data);
-                    specificMatches.add(Match(job->getId(), current->data.getId(), score, skillCount));
-                    current = current->next;
+                if (!skillIndex.isBuilt()) {
+                    auto startBuild = high_resolution_clock::now();
+                    skillIndex.build(jobList, resumeList);
+                    auto endBuild = high_resolution_clock::now();
+                    cout << "Skill index built in " 
+                         << duration_cast<microseconds>(endBuild - startBuild).count() 
+                         << " microseconds" << endl;
                 }
                 
+                MatchArray specificMatches(10);
+                auto startQuery = high_resolution_clock::now();
+                skillIndex.topCandidatesForJob(jobId, 10, specificMatches);
+                auto endQuery = high_resolution_clock::now();
+                long long queryTime = duration_cast<microseconds>(endQuery - startQuery).count();
+                
                 displayTopMatches_LL(specificMatches, 10, jobList, resumeList);
+                cout << "Query time: " << queryTime << " microseconds" << endl;
                 break;
             }
             
@@ -316,17 +369,23 @@ void runLinkedListImplementation() {
                 cout << "\nMatching candidate with all jobs..." << endl;
                 resume->displayDetailed();
                 
-                MatchArray specificMatches(jobList.getSize());
-                JobNode* current = jobList.getHead();
-                
-                while (current != nullptr) {
-                    double score = MatchingEngine::calculateMatchScore(current->data, *resume);
-                    int skillCount = MatchingEngine::countMatchingSkills(current->data, *resume);
-                    specificMatches.add(Match(current->data.getId(), resume->getId(), score, skillCount));
-                    current = current->next;
+                if (!skillIndex.isBuilt()) {
+                    auto startBuild = high_resolution_clock::now();
+                    skillIndex.build(jobList, resumeList);
+                    auto endBuild = high_resolution_clock::now();
+                    cout << "Skill index built in " 
+                         << duration_cast<microseconds>(endBuild - startBuild).count() 
+                         << " microseconds" << endl;
                 }
                 
+                MatchArray specificMatches(10);
+                auto startQuery = high_resolution_clock::now();
+                skillIndex.topJobsForResume(resumeId, 10, specificMatches);
+                auto endQuery = high_resolution_clock::now();
+                long long queryTime = duration_cast<microseconds>(endQuery - startQuery).count();
+                
                 displayTopMatches_LL(specificMatches, 10, jobList, resumeList);
+                cout << "Query time: " << queryTime << " microseconds" << endl;
                 break;
             }
             
@@ -337,6 +396,26 @@ void runLinkedListImplementation() {
                 break;
             }
             
+            case 12: {
+                if (!skillQueriesBuilt) {
+                    auto startBuild = high_resolution_clock::now();
+                    buildSkillQueries_LL(jobList, resumeList, jobQuery, resumeQuery);
+                    auto endBuild = high_resolution_clock::now();
+                    skillQueriesBuilt = true;
+                    cout << "Skill bitmaps built in " 
+                         << duration_cast<microseconds>(endBuild - startBuild).count() 
+                         << " microseconds ("
+                         << (jobQuery.sizeInBytes() + resumeQuery.sizeInBytes()) / 1024 << " KB)" << endl;
+                }
+                runSkillQuery_LL(jobList, resumeList, jobQuery, resumeQuery);
+                break;
+            }
+            
+            case 13: {
+                runFuzzySearch_LL(jobList, resumeList, titleIndex, nameIndex);
+                break;
+            }
+            
             case 0: {
                 cout << "\nReturning to main menu..." << endl;
                 running = false;
@@ -355,7 +434,57 @@ void runLinkedListImplementation() {
     }
 }
 
-void loadJobsFromCSV_LL(const char* filename, JobLinkedList& jobList) {
+// Rebuild the lists from a binary snapshot (see Snapshot.hpp) instead of the CSV
+bool loadJobsFromSnapshot_LL(const char* filename, unsigned long long sourceKey, JobLinkedList& jobList,
+                             TrigramIndex& titleIndex) {
+    SnapshotReader snap;
+    if (!snap.open(Snapshot::pathFor(filename, "linkedlist"), sourceKey,
+                   Snapshot::vocabularyKey(COMMON_SKILLS, SKILLS_COUNT))) {
+        return false;
+    }
+    
+    // Descriptions stay in the mapped snapshot until displayed
+    shared_ptr<const TextSource> text = snap.shareText();
+    for (int i = 0; i < snap.size(); i++) {
+        const SnapshotRecord& r = snap.record(i);
+        Job& job = jobList.emplace_back(r.id, snap.titleString(i), "Tech Company", string(), r.years);
+        job.setDescription(LazyText(text, snap.textRef(i)));
+        titleIndex.add(r.id, job.getTitle());
+        for (int s = 0; s < SKILLS_COUNT; s++) {
+            if (r.skillMask & (1ULL << s)) job.addSkill(COMMON_SKILLS[s]);
+        }
+    }
+    text->evict();      // titles were read from the mapping
+    cout << "Loaded " << snap.size() << " jobs from snapshot" << endl;
+    return true;
+}
+
+bool loadResumesFromSnapshot_LL(const char* filename, unsigned long long sourceKey, ResumeLinkedList& resumeList,
+                                TrigramIndex& nameIndex) {
+    SnapshotReader snap;
+    if (!snap.open(Snapshot::pathFor(filename, "linkedlist"), sourceKey,
+                   Snapshot::vocabularyKey(COMMON_SKILLS, SKILLS_COUNT))) {
+        return false;
+    }
+    
+    shared_ptr<const TextSource> text = snap.shareText();
+    for (int i = 0; i < snap.size(); i++) {
+        const SnapshotRecord& r = snap.record(i);
+        Resume& resume = resumeList.emplace_back(r.id, string(), r.years);
+        resume.setSummary(LazyText(text, snap.textRef(i)));
+        nameIndex.add(r.id, resume.getName());
+        for (int s = 0; s < SKILLS_COUNT; s++) {
+            if (r.skillMask & (1ULL << s)) resume.addSkill(COMMON_SKILLS[s]);
+        }
+    }
+    cout << "Loaded " << snap.size() << " resumes from snapshot" << endl;
+    return true;
+}
+
+void loadJobsFromCSV_LL(const char* filename, JobLinkedList& jobList, TrigramIndex& titleIndex) {
+    unsigned long long sourceKey = Snapshot::sourceKey(filename);
+    if (loadJobsFromSnapshot_LL(filename, sourceKey, jobList, titleIndex)) return;
+    
     ifstream file(filename);
     if (!file.is_open()) {
         cout << "Error: Could not open " << filename << endl;
@@ -367,6 +496,8 @@ void loadJobsFromCSV_LL(const char* filename, JobLinkedList& jobList) {
     
     int id = 1;
     int count = 0;
+    int before = jobList.getSize();
+    SnapshotWriter snap;
     
     cout << "Loading jobs: ";
     
@@ -401,19 +532,33 @@ void loadJobsFromCSV_LL(const char* filename, JobLinkedList& jobList) {
             title = line.substr(0, requiredPos);
         }
         
-        Job job(id, title, "Tech Company", line, 3);
-        extractSkills(line, &job, nullptr);
+        // Build the job directly inside its list node; the description is
+        // attached below, once it has a place in the snapshot's text area
+        Job& job = jobList.emplace_back(id, std::move(title), "Tech Company", string(), 3);
+        unsigned long long mask = extractSkills(line, &job, nullptr);
+        snap.add(id, job.getExperienceRequired(), mask, job.getTitle(), line);
+        titleIndex.add(id, job.getTitle());
         
-        jobList.insert(job);
         id++;
         count++;
     }
     
     cout << " Done!" << endl;
     file.close();
+    
+    shared_ptr<const TextSource> text =
+        snap.writeAndShareText(Snapshot::pathFor(filename, "linkedlist"), sourceKey,
+                               Snapshot::vocabularyKey(COMMON_SKILLS, SKILLS_COUNT));
+    int k = 0;
+    for (JobLinkedList::Node* node = jobList.getHead(); node != nullptr; node = node->next, k++) {
+        if (k >= before) node->data.setDescription(LazyText(text, snap.textRef(k - before)));
+    }
 }
 
-void loadResumesFromCSV_LL(const char* filename, ResumeLinkedList& resumeList) {
+void loadResumesFromCSV_LL(const char* filename, ResumeLinkedList& resumeList, TrigramIndex& nameIndex) {
+    unsigned long long sourceKey = Snapshot::sourceKey(filename);
+    if (loadResumesFromSnapshot_LL(filename, sourceKey, resumeList, nameIndex)) return;
+    
     ifstream file(filename);
     if (!file.is_open()) {
         cout << "Error: Could not open " << filename << endl;
@@ -425,6 +570,8 @@ void loadResumesFromCSV_LL(const char* filename, ResumeLinkedList& resumeList) {
     
     int id = 101;
     int count = 0;
+    int before = resumeList.getSize();
+    SnapshotWriter snap;
     
     cout << "Loading resumes: ";
     
@@ -448,27 +595,37 @@ void loadResumesFromCSV_LL(const char* filename, ResumeLinkedList& resumeList) {
             cout.flush();
         }
         
-        string candidateName = "Candidate_" + to_string(id);
-        string email = "candidate" + to_string(id) + "@email.com";
+        // Build the resume directly inside its list node (name and email
+        // are derived from the id when displayed, the summary is attached below)
+        Resume& resume = resumeList.emplace_back(id, string(), 2);
+        unsigned long long mask = extractSkills(line, nullptr, &resume);
+        snap.add(id, resume.getYearsOfExperience(), mask, "", line);
+        nameIndex.add(id, resume.getName());
         
-        Resume resume(id, candidateName, email, line, 2);
-        extractSkills(line, nullptr, &resume);
-        
-        resumeList.insert(resume);
         id++;
         count++;
     }
     
     cout << " Done!" << endl;
     file.close();
+    
+    shared_ptr<const TextSource> text =
+        snap.writeAndShareText(Snapshot::pathFor(filename, "linkedlist"), sourceKey,
+                               Snapshot::vocabularyKey(COMMON_SKILLS, SKILLS_COUNT));
+    int k = 0;
+    for (ResumeLinkedList::Node* node = resumeList.getHead(); node != nullptr; node = node->next, k++) {
+        if (k >= before) node->data.setSummary(LazyText(text, snap.textRef(k - before)));
+    }
 }
 
-void extractSkills(const string& text, Job* job, Resume* resume) {
+// Returns a mask of the skills actually stored (bit i = COMMON_SKILLS[i])
+unsigned long long extractSkills(const string& text, Job* job, Resume* resume) {
     string lowerText = text;
     for (size_t i = 0; i < lowerText.length(); i++) {
         lowerText[i] = tolower(lowerText[i]);
     }
     
+    unsigned long long mask = 0;
     for (int i = 0; i < SKILLS_COUNT; i++) {
         string lowerSkill = COMMON_SKILLS[i];
         for (size_t j = 0; j < lowerSkill.length(); j++) {
@@ -476,13 +633,16 @@ void extractSkills(const string& text, Job* job, Resume* resume) {
         }
         
         if (lowerText.find(lowerSkill) != string::npos) {
+            bool added = false;
             if (job != nullptr) {
-                job->addSkill(COMMON_SKILLS[i]);
+                added = job->addSkill(COMMON_SKILLS[i]);
             } else if (resume != nullptr) {
-                resume->addSkill(COMMON_SKILLS[i]);
+                added = resume->addSkill(COMMON_SKILLS[i]);
             }
+            if (added) mask |= 1ULL << i;
         }
     }
+    return mask;
 }
 
 // OPTIMIZED: Added progress indicator
@@ -528,6 +688,7 @@ void displayTopMatches_LL(const MatchArray& matches, int top, JobLinkedList& job
         return;
     }
     
+    CounterPhase topCounters;
     Match* sortedMatches = new Match[matches.size];
     for (int i = 0; i < matches.size; i++) {
         sortedMatches[i] = matches.matches[i];
@@ -543,6 +704,7 @@ void displayTopMatches_LL(const MatchArray& matches, int top, JobLinkedList& job
             }
         }
     }
+    g_llCounters.phases[PHASE_TOPK] = topCounters.finish();
     
     int displayCount = (top < matches.size) ? top : matches.size;
     
@@ -566,6 +728,139 @@ void displayTopMatches_LL(const MatchArray& matches, int top, JobLinkedList& job
     delete[] sortedMatches;
 }
 
+// One bitmap of record ids per skill, for Boolean queries
+void buildSkillQueries_LL(const JobLinkedList& jobList, const ResumeLinkedList& resumeList,
+                          SkillQueryIndex& jobQuery, SkillQueryIndex& resumeQuery) {
+    // Vocabulary first, so skills nobody has are still valid in a query
+    for (int s = 0; s < SKILLS_COUNT; s++) {
+        jobQuery.defineSkill(COMMON_SKILLS[s]);
+        resumeQuery.defineSkill(COMMON_SKILLS[s]);
+    }
+    
+    for (JobNode* cur = jobList.getHead(); cur != nullptr; cur = cur->next) {
+        const Job& job = cur->data;
+        jobQuery.addRecord(job.getId());
+        for (int i = 0; i < job.getSkillCount(); i++) {
+            jobQuery.addSkill(job.getId(), job.getSkill(i));
+        }
+    }
+    for (ResumeNode* cur = resumeList.getHead(); cur != nullptr; cur = cur->next) {
+        const Resume& resume = cur->data;
+        resumeQuery.addRecord(resume.getId());
+        for (int i = 0; i < resume.getSkillCount(); i++) {
+            resumeQuery.addSkill(resume.getId(), resume.getSkill(i));
+        }
+    }
+    jobQuery.finish();
+    resumeQuery.finish();
+}
+
+// Rest of the input line; the newline stays in the stream, as after cin >>
+static string readRestOfLine() {
+    string line;
+    while (cin.peek() != '\n' && cin.peek() != EOF) {
+        line += (char)cin.get();
+    }
+    return line;
+}
+
+void runSkillQuery_LL(JobLinkedList& jobList, ResumeLinkedList& resumeList,
+                      const SkillQueryIndex& jobQuery, const SkillQueryIndex& resumeQuery) {
+    int side;
+    cout << "\nSearch (1) jobs or (2) resumes: ";
+    if (!(cin >> side) || (side != 1 && side != 2)) {
+        cin.clear();
+        cout << "Invalid choice!" << endl;
+        return;
+    }
+    const SkillQueryIndex& index = (side == 1) ? jobQuery : resumeQuery;
+    
+    cout << "Query (e.g. python AND sql AND NOT java): ";
+    cin >> ws;
+    string expression = readRestOfLine();
+    
+    CompressedBitmap result;
+    string error;
+    auto startQuery = high_resolution_clock::now();
+    bool ok = index.evaluate(expression, result, error);
+    auto endQuery = high_resolution_clock::now();
+    
+    if (!ok) {
+        cout << "Invalid query: " << error << endl;
+        cout << "Known skills: ";
+        for (int s = 0; s < index.skillCount(); s++) {
+            cout << (s > 0 ? ", " : "") << index.skillName(s);
+        }
+        cout << endl;
+        return;
+    }
+    
+    int total = result.cardinality();
+    cout << "\n" << total << " of " << index.recordCount()
+         << (side == 1 ? " jobs" : " resumes") << " match" << endl;
+    
+    const int SHOWN = 10;
+    int ids[SHOWN];
+    int shown = result.toArray(ids, SHOWN);
+    for (int i = 0; i < shown; i++) {
+        cout << endl;
+        if (side == 1) {
+            Job* job = jobList.search(ids[i]);
+            if (job != nullptr) job->display();
+        } else {
+            Resume* resume = resumeList.search(ids[i]);
+            if (resume != nullptr) resume->display();
+        }
+    }
+    if (total > shown) cout << "\n... and " << (total - shown) << " more" << endl;
+    cout << "Query time: " << duration_cast<microseconds>(endQuery - startQuery).count() 
+         << " microseconds" << endl;
+}
+
+// Approximate title / name lookup ("data sci" -> Data Scientist)
+void runFuzzySearch_LL(JobLinkedList& jobList, ResumeLinkedList& resumeList,
+                       const TrigramIndex& titleIndex, const TrigramIndex& nameIndex) {
+    int side;
+    cout << "\nSearch (1) job titles or (2) candidate names: ";
+    if (!(cin >> side) || (side != 1 && side != 2)) {
+        cin.clear();
+        cout << "Invalid choice!" << endl;
+        return;
+    }
+    const TrigramIndex& index = (side == 1) ? titleIndex : nameIndex;
+    
+    cout << "Search for: ";
+    cin >> ws;
+    string query = readRestOfLine();
+    
+    const int SHOWN = 10;
+    TrigramIndex::Hit hits[SHOWN];
+    int verified = 0;
+    auto startQuery = high_resolution_clock::now();
+    int shown = index.search(query, SHOWN, hits, verified);
+    auto endQuery = high_resolution_clock::now();
+    
+    if (shown == 0) cout << "\nNo close matches." << endl;
+    for (int i = 0; i < shown; i++) {
+        int entry = hits[i].entry;
+        int records = index.entryRecordCount(entry);
+        int first = index.entryRecords(entry)[0];
+        cout << "\n[" << (int)(hits[i].similarity * 100 + 0.5) << "% similar"
+             << (hits[i].containsQuery ? ", contains query" : "") << "]" << endl;
+        if (side == 1) {
+            Job* job = jobList.search(first);
+            if (job != nullptr) job->display();
+            if (records > 1) cout << "... and " << (records - 1) << " more jobs with this title" << endl;
+        } else {
+            Resume* resume = resumeList.search(first);
+            if (resume != nullptr) resume->display();
+        }
+    }
+    cout << "Query time: " << duration_cast<microseconds>(endQuery - startQuery).count() 
+         << " microseconds (" << verified << " candidates verified, " 
+         << index.entryCount() << (side == 1 ? " distinct titles" : " names") << " indexed)" << endl;
+}
+
 void displayMenu_LL() {
     cout << "\n===============================================" << endl;
     cout << "            LINKED LIST MENU" << endl;
@@ -581,6 +876,8 @@ void displayMenu_LL() {
     cout << "  9. Match Specific Job with All Resumes" << endl;
     cout << " 10. Match Specific Resume with All Jobs" << endl;
     cout << " 11. Display Performance Metrics" << endl;
+    cout << " 12. Boolean Skill Query (AND / OR / NOT)" << endl;
+    cout << " 13. Fuzzy Search (job titles / candidate names)" << endl;
     cout << "  0. Return to Main Menu" << endl;
     cout << "===============================================" << endl;
 }
@@ -731,6 +1028,9 @@ void comparePerformance(ArrayPerf arrayPerf, long long llLoadTime, long long llM
     
     cout << "================================================================\n" << endl;
     
+    compareMemory(arrayPerf, llJobs, llResumes);
+    compareCounters(arrayPerf);
+    
     // Performance Analysis
     if (hasArrayData && hasLLData) {
         cout << "SPEED COMPARISON:" << endl;
@@ -871,4 +1171,134 @@ void comparePerformance(ArrayPerf arrayPerf, long long llLoadTime, long long llM
         }
         cout << endl;
     }
+}
+
+// One cell of the memory table: "Not Run" if the engine hasn't run,
+// "n/a" if the value wasn't measured
+static void printMemoryCell(bool ran, bool measured, double value, int precision) {
+    if (!ran) {
+        cout << setw(20) << "Not Run";
+    } else if (!measured) {
+        cout << setw(20) << "n/a";
+    } else {
+        cout << setw(20) << fixed << setprecision(precision) << value;
+    }
+}
+
+// Heap and RSS cost of each engine, per record, from the load and match phases
+void compareMemory(const ArrayPerf& arrayPerf, int llJobs, int llResumes) {
+    bool hasArrayData = (arrayPerf.jobs > 0);
+    bool hasLLData = (llJobs > 0);
+    bool heap = allocTrackingEnabled();
+    
+    const PhaseMemory& aj = arrayPerf.jobsMemory;
+    const PhaseMemory& ar = arrayPerf.resumesMemory;
+    const PhaseMemory& lj = g_llJobsMemory;
+    const PhaseMemory& lr = g_llResumesMemory;
+    double aJobs = arrayPerf.jobs > 0 ? arrayPerf.jobs : 1;
+    double aResumes = arrayPerf.resumes > 0 ? arrayPerf.resumes : 1;
+    double lJobs = llJobs > 0 ? llJobs : 1;
+    double lResumes = llResumes > 0 ? llResumes : 1;
+    
+    // Highest heap use while loading both containers
+    long long aPeak = aj.peakBytes > aj.liveBytes + ar.peakBytes ? aj.peakBytes : aj.liveBytes + ar.peakBytes;
+    long long lPeak = lj.peakBytes > lj.liveBytes + lr.peakBytes ? lj.peakBytes : lj.liveBytes + lr.peakBytes;
+    
+    cout << "MEMORY FOOTPRINT:" << endl;
+    cout << "================================================================" << endl;
+    cout << left << setw(30) << "Job Allocations/Record";
+    printMemoryCell(hasArrayData, heap, aj.allocations / aJobs, 2);
+    printMemoryCell(hasLLData, heap, lj.allocations / lJobs, 2);
+    cout << endl;
+    
+    cout << left << setw(30) << "Job Bytes/Record";
+    printMemoryCell(hasArrayData, heap, aj.liveBytes / aJobs, 0);
+    printMemoryCell(hasLLData, heap, lj.liveBytes / lJobs, 0);
+    cout << endl;
+    
+    cout << left << setw(30) << "Resume Allocations/Record";
+    printMemoryCell(hasArrayData, heap, ar.allocations / aResumes, 2);
+    printMemoryCell(hasLLData, heap, lr.allocations / lResumes, 2);
+    cout << endl;
+    
+    cout << left << setw(30) << "Resume Bytes/Record";
+    printMemoryCell(hasArrayData, heap, ar.liveBytes / aResumes, 0);
+    printMemoryCell(hasLLData, heap, lr.liveBytes / lResumes, 0);
+    cout << endl;
+    
+    cout << left << setw(30) << "Peak Heap, Load (KB)";
+    printMemoryCell(hasArrayData, heap, aPeak / 1024.0, 0);
+    printMemoryCell(hasLLData, heap, lPeak / 1024.0, 0);
+    cout << endl;
+    
+    cout << left << setw(30) << "Allocations, Matching";
+    printMemoryCell(hasArrayData, heap && arrayPerf.match_us > 0, (double)arrayPerf.matchMemory.allocations, 0);
+    printMemoryCell(hasLLData, heap && g_llMatchTime > 0, (double)g_llMatchMemory.allocations, 0);
+    cout << endl;
+    
+    cout << left << setw(30) << "Peak Heap, Matching (KB)";
+    printMemoryCell(hasArrayData, heap && arrayPerf.match_us > 0, arrayPerf.matchMemory.peakBytes / 1024.0, 0);
+    printMemoryCell(hasLLData, heap && g_llMatchTime > 0, g_llMatchMemory.peakBytes / 1024.0, 0);
+    cout << endl;
+    
+    cout << left << setw(30) << "RSS Growth, Load (KB)";
+    printMemoryCell(hasArrayData, ar.rssBytes > 0, (aj.rssGrowth + ar.rssGrowth) / 1024.0, 0);
+    printMemoryCell(hasLLData, lr.rssBytes > 0, (lj.rssGrowth + lr.rssGrowth) / 1024.0, 0);
+    cout << endl;
+    cout << "================================================================" << endl;
+    
+    long long peakRss = peakRssBytes();
+    if (peakRss > 0) cout << "Process peak RSS: " << (peakRss / 1024) << " KB" << endl;
+    if (!heap) cout << "Heap counters need a build with -DJM_TRACK_ALLOCATIONS." << endl;
+    cout << endl;
+}
+
+// One cell of the counter table; counter -1 is instructions per cycle
+static void printCounterCell(const CounterSample& sample, int counter) {
+    if (counter < 0) {
+        double ipc = sample.ipc();
+        if (ipc >= 0) cout << setw(20) << fixed << setprecision(2) << ipc;
+        else cout << setw(20) << "n/a";
+    } else {
+        cout << setw(20) << formatCount(sample.values[counter]);
+    }
+}
+
+static void printCounterRow(int phase, int counter, const CounterSample& a, const CounterSample& l) {
+    string label = string(perfPhaseName(phase)) + " " + (counter < 0 ? "IPC" : hwCounterName(counter));
+    cout << left << setw(30) << label;
+    printCounterCell(a, counter);
+    printCounterCell(l, counter);
+    cout << endl;
+}
+
+// Hardware counters per phase for both engines (phases neither engine ran are skipped)
+void compareCounters(const ArrayPerf& arrayPerf) {
+    bool any = false;
+    for (int p = 0; p < PHASE_COUNT; p++) {
+        if (arrayPerf.counters.phases[p].available() || g_llCounters.phases[p].available()) any = true;
+    }
+    
+    cout << "HARDWARE COUNTERS:" << endl;
+    if (!any) {
+        string status = hwCountersStatus();
+        cout << "Not available";
+        if (!status.empty()) cout << " (" << status << ")";
+        cout << ".\nCheck /proc/sys/kernel/perf_event_paranoid, or run on hardware that exposes a PMU.\n" << endl;
+        return;
+    }
+    
+    cout << "================================================================" << endl;
+    for (int p = 0; p < PHASE_COUNT; p++) {
+        const CounterSample& a = arrayPerf.counters.phases[p];
+        const CounterSample& l = g_llCounters.phases[p];
+        if (!a.available() && !l.available()) continue;
+        
+        for (int c = 0; c < HW_COUNTER_COUNT; c++) {
+            printCounterRow(p, c, a, l);
+            if (c == HW_INSTRUCTIONS) printCounterRow(p, -1, a, l);
+        }
+        cout << "----------------------------------------------------------------" << endl;
+    }
+    cout << "Linked list skill extraction is counted in its Load phase.\n" << endl;
 }
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include "AllocTracker.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+// Process-wide counters, updated by the operator new/delete hooks below
+static std::atomic<long long> g_allocations(0);
+static std::atomic<long long> g_bytes(0);
+static std::atomic<long long> g_live(0);
+static std::atomic<long long> g_peak(0);
+
+#ifdef JM_TRACK_ALLOCATIONS
+
+// Every block carries its size in a header so delete can account for it.
+// The header keeps the user pointer aligned like malloc's.
+static const size_t HEADER = alignof(std::max_align_t);
+
+static void* trackedAlloc(size_t size) {
+    unsigned char* block = (unsigned char*)std::malloc(size + HEADER);
+    if (block == nullptr) return nullptr;
+    *(size_t*)block = size;
+
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_bytes.fetch_add((long long)size, std::memory_order_relaxed);
+    long long live = g_live.fetch_add((long long)size, std::memory_order_relaxed) + (long long)size;
+    long long peak = g_peak.load(std::memory_order_relaxed);
+    while (live > peak && !g_peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+    return block + HEADER;
+}
+
+static void trackedFree(void* p) {
+    if (p == nullptr) return;
+    unsigned char* block = (unsigned char*)p - HEADER;
+    g_live.fetch_sub((long long)*(size_t*)block, std::memory_order_relaxed);
+    std::free(block);
+}
+
+static void* trackedNew(size_t size) {
+    if (size == 0) size = 1;
+    for (;;) {
+        void* p = trackedAlloc(size);
+        if (p != nullptr) return p;
+        std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) throw std::bad_alloc();
+        handler();
+    }
+}
+
+void* operator new(size_t size) { return trackedNew(size); }
+void* operator new[](size_t size) { return trackedNew(size); }
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    try { return trackedNew(size); } catch (...) { return nullptr; }
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    try { return trackedNew(size); } catch (...) { return nullptr; }
+}
+
+void operator delete(void* p) noexcept { trackedFree(p); }
+void operator delete[](void* p) noexcept { trackedFree(p); }
+void operator delete(void* p, size_t) noexcept { trackedFree(p); }
+void operator delete[](void* p, size_t) noexcept { trackedFree(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { trackedFree(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { trackedFree(p); }
+
+bool allocTrackingEnabled() { return true; }
+
+#else
+
+bool allocTrackingEnabled() { return false; }
+
+#endif
+
+long long currentRssBytes() {
+#ifndef _WIN32
+    // Second field of /proc/self/statm is resident pages (Linux)
+    FILE* f = std::fopen("/proc/self/statm", "r");
+    if (f == nullptr) return 0;
+    long long size = 0, resident = 0;
+    int fields = std::fscanf(f, "%lld %lld", &size, &resident);
+    std::fclose(f);
+    if (fields != 2) return 0;
+    return resident * (long long)sysconf(_SC_PAGESIZE);
+#else
+    return 0;
+#endif
+}
+
+long long peakRssBytes() {
+#ifndef _WIN32
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    return (long long)usage.ru_maxrss;            // bytes on macOS
+#else
+    return (long long)usage.ru_maxrss * 1024;     // kilobytes on Linux
+#endif
+#else
+    return 0;
+#endif
+}
+
+// MemoryPhase
+MemoryPhase::MemoryPhase() {
+    startAllocations = g_allocations.load();
+    startBytes = g_bytes.load();
+    startLive = g_live.load();
+    startRss = currentRssBytes();
+    g_peak.store(startLive);        // peak is measured from here
+}
+
+PhaseMemory MemoryPhase::finish() const {
+    PhaseMemory m;
+    m.allocations = g_allocations.load() - startAllocations;
+    m.bytes = g_bytes.load() - startBytes;
+    m.liveBytes = g_live.load() - startLive;
+    m.peakBytes = g_peak.load() - startLive;
+    m.rssBytes = currentRssBytes();
+    m.rssGrowth = m.rssBytes - startRss;
+    return m;
+}
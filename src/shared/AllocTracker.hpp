@@ -0,0 +1,45 @@
+#ifndef ALLOCTRACKER_HPP
+#define ALLOCTRACKER_HPP
+
+// Heap and resident-memory accounting for the performance comparison.
+//
+// In an instrumented build (compile with -DJM_TRACK_ALLOCATIONS) the global
+// operator new/delete are replaced by versions that count allocations,
+// bytes, live bytes and peak live bytes. Without the flag the counters stay
+// at zero and only resident set size (RSS) is sampled.
+//
+// A MemoryPhase measures the span from its construction to finish(). Phases
+// don't nest, and the counters are process-wide, so a phase also sees
+// allocations made by other threads while it runs.
+
+struct PhaseMemory {
+    long long allocations;    // operator new calls
+    long long bytes;          // bytes requested
+    long long liveBytes;      // bytes still allocated at the end (net)
+    long long peakBytes;      // highest live bytes above the starting level
+    long long rssBytes;       // resident set size at the end
+    long long rssGrowth;      // change in resident set size
+
+    PhaseMemory() : allocations(0), bytes(0), liveBytes(0), peakBytes(0), rssBytes(0), rssGrowth(0) {}
+};
+
+// True when built with -DJM_TRACK_ALLOCATIONS
+bool allocTrackingEnabled();
+
+// Current and peak resident set size in bytes (0 where not available)
+long long currentRssBytes();
+long long peakRssBytes();
+
+class MemoryPhase {
+private:
+    long long startAllocations;
+    long long startBytes;
+    long long startLive;
+    long long startRss;
+
+public:
+    MemoryPhase();
+    PhaseMemory finish() const;
+};
+
+#endif
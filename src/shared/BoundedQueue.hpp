@@ -0,0 +1,187 @@
+#ifndef BOUNDEDQUEUE_HPP
+#define BOUNDEDQUEUE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+
+// Fixed-capacity lock-free queues for passing work between pipeline stages.
+// push() waits while the queue is full, which is what throttles a fast
+// producer to the pace of its consumer (backpressure). When producers are
+// finished they call close(); pop() then drains what is left and returns
+// false once the queue is empty.
+//
+// Capacity is rounded up to a power of two. T should be cheap to copy
+// (the pipelines pass pointers to batches).
+
+// Waiting strategy shared by both queues: spin briefly, then yield, then sleep
+// so a blocked stage doesn't burn a core the others need
+class QueueBackoff {
+private:
+    int rounds;
+
+public:
+    QueueBackoff() : rounds(0) {}
+
+    void wait() {
+        if (rounds < 64) {
+            rounds++;
+        } else if (rounds < 256) {
+            rounds++;
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+};
+
+static inline size_t queueCapacityFor(size_t requested) {
+    size_t capacity = 2;
+    while (capacity < requested) capacity *= 2;
+    return capacity;
+}
+
+// Single producer / single consumer ring buffer
+template <typename T>
+class SpscQueue {
+private:
+    T* slots;
+    size_t mask;
+    alignas(64) std::atomic<size_t> head;     // next slot to pop (consumer)
+    alignas(64) std::atomic<size_t> tail;     // next slot to push (producer)
+    alignas(64) std::atomic<bool> closed;
+
+public:
+    explicit SpscQueue(size_t capacity) : head(0), tail(0), closed(false) {
+        size_t n = queueCapacityFor(capacity);
+        slots = new T[n];
+        mask = n - 1;
+    }
+    ~SpscQueue() { delete[] slots; }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    bool tryPush(const T& item) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) > mask) return false;   // full
+        slots[t & mask] = item;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(T& item) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) return false;         // empty
+        item = slots[h & mask];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    void push(const T& item) {
+        QueueBackoff backoff;
+        while (!tryPush(item)) backoff.wait();
+    }
+
+    // Waits for an item; false once the queue is closed and drained
+    bool pop(T& item) {
+        QueueBackoff backoff;
+        while (!tryPop(item)) {
+            if (closed.load(std::memory_order_acquire)) return tryPop(item);
+            backoff.wait();
+        }
+        return true;
+    }
+
+    void close() { closed.store(true, std::memory_order_release); }
+};
+
+// Multi producer / multi consumer queue (bounded, per-slot sequence numbers).
+// With several producers, close() takes effect after it has been called
+// once per producer.
+template <typename T>
+class MpmcQueue {
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    Cell* cells;
+    size_t mask;
+    alignas(64) std::atomic<size_t> head;
+    alignas(64) std::atomic<size_t> tail;
+    alignas(64) std::atomic<int> openProducers;
+
+public:
+    MpmcQueue(size_t capacity, int producers = 1) : head(0), tail(0), openProducers(producers) {
+        size_t n = queueCapacityFor(capacity);
+        cells = new Cell[n];
+        for (size_t i = 0; i < n; i++) cells[i].sequence.store(i, std::memory_order_relaxed);
+        mask = n - 1;
+    }
+    ~MpmcQueue() { delete[] cells; }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    bool tryPush(const T& item) {
+        size_t pos = tail.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells[pos & mask];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            long long diff = (long long)seq - (long long)pos;
+            if (diff == 0) {
+                if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;                                   // full
+            } else {
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+        cell->data = item;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(T& item) {
+        size_t pos = head.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells[pos & mask];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            long long diff = (long long)seq - (long long)(pos + 1);
+            if (diff == 0) {
+                if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;                                   // empty
+            } else {
+                pos = head.load(std::memory_order_relaxed);
+            }
+        }
+        item = cell->data;
+        cell->sequence.store(pos + mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    void push(const T& item) {
+        QueueBackoff backoff;
+        while (!tryPush(item)) backoff.wait();
+    }
+
+    // Waits for an item; false once every producer has closed and the queue is drained
+    bool pop(T& item) {
+        QueueBackoff backoff;
+        while (!tryPop(item)) {
+            if (openProducers.load(std::memory_order_acquire) <= 0) return tryPop(item);
+            backoff.wait();
+        }
+        return true;
+    }
+
+    void close() { openProducers.fetch_sub(1, std::memory_order_acq_rel); }
+};
+
+#endif
@@ -0,0 +1,550 @@
+#include "CompressedBitmap.hpp"
+#include <cstring>
+
+// Number of set bits (SWAR; the builtin is a library call without -mpopcnt)
+static inline int bitCount(unsigned long long x) {
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (int)((x * 0x0101010101010101ULL) >> 56);
+}
+
+// Set bits [start, end] (inclusive)
+static void setRange(unsigned long long* words, int start, int end) {
+    int first = start >> 6, last = end >> 6;
+    unsigned long long firstMask = ~0ULL << (start & 63);
+    unsigned long long lastMask = ~0ULL >> (63 - (end & 63));
+    if (first == last) {
+        words[first] |= firstMask & lastMask;
+        return;
+    }
+    words[first] |= firstMask;
+    for (int i = first + 1; i < last; i++) words[i] = ~0ULL;
+    words[last] |= lastMask;
+}
+
+// Constructors & Destructor
+CompressedBitmap::CompressedBitmap() : containers(nullptr), count(0), capacity(0) {}
+
+CompressedBitmap::~CompressedBitmap() {
+    clear();
+}
+
+CompressedBitmap::CompressedBitmap(const CompressedBitmap& other)
+    : containers(nullptr), count(0), capacity(0) {
+    copyFrom(other);
+}
+
+CompressedBitmap::CompressedBitmap(CompressedBitmap&& other) noexcept
+    : containers(other.containers), count(other.count), capacity(other.capacity) {
+    other.containers = nullptr;
+    other.count = other.capacity = 0;
+}
+
+CompressedBitmap& CompressedBitmap::operator=(const CompressedBitmap& other) {
+    if (this != &other) {
+        clear();
+        copyFrom(other);
+    }
+    return *this;
+}
+
+CompressedBitmap& CompressedBitmap::operator=(CompressedBitmap&& other) noexcept {
+    if (this != &other) {
+        clear();
+        containers = other.containers;
+        count = other.count;
+        capacity = other.capacity;
+        other.containers = nullptr;
+        other.count = other.capacity = 0;
+    }
+    return *this;
+}
+
+void CompressedBitmap::freeContainer(Container& c) {
+    delete[] c.values;
+    delete[] c.words;
+    c.values = nullptr;
+    c.words = nullptr;
+}
+
+void CompressedBitmap::clear() {
+    for (int i = 0; i < count; i++) freeContainer(containers[i]);
+    delete[] containers;
+    containers = nullptr;
+    count = capacity = 0;
+}
+
+CompressedBitmap::Container CompressedBitmap::copyContainer(const Container& from) {
+    Container c = from;
+    if (from.values != nullptr) {
+        int shorts = from.type == RUN ? 2 * from.capacity : from.capacity;
+        c.values = new unsigned short[shorts > 0 ? shorts : 1];
+        memcpy(c.values, from.values, sizeof(unsigned short) * shorts);
+    }
+    if (from.words != nullptr) {
+        c.words = new unsigned long long[BITSET_WORDS];
+        memcpy(c.words, from.words, sizeof(unsigned long long) * BITSET_WORDS);
+    }
+    return c;
+}
+
+void CompressedBitmap::copyFrom(const CompressedBitmap& other) {
+    if (other.count == 0) return;
+    containers = new Container[other.count];
+    capacity = other.count;
+    for (int i = 0; i < other.count; i++) containers[i] = copyContainer(other.containers[i]);
+    count = other.count;
+}
+
+// Index of the container for key, or -(insertion point) - 1
+int CompressedBitmap::findContainer(unsigned short key) const {
+    int lo = 0, hi = count - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        if (containers[mid].key == key) return mid;
+        if (containers[mid].key < key) lo = mid + 1;
+        else hi = mid - 1;
+    }
+    return -(lo + 1);
+}
+
+// New empty array container at position at
+CompressedBitmap::Container& CompressedBitmap::insertContainer(int at, unsigned short key) {
+    if (count == capacity) {
+        int bigger = capacity > 0 ? capacity * 2 : 4;
+        Container* grown = new Container[bigger];
+        if (count > 0) memcpy(grown, containers, sizeof(Container) * count);
+        delete[] containers;
+        containers = grown;
+        capacity = bigger;
+    }
+    memmove(containers + at + 1, containers + at, sizeof(Container) * (count - at));
+    count++;
+    Container& c = containers[at];
+    c.key = key;
+    c.type = ARRAY;
+    c.cardinality = 0;
+    c.size = 0;
+    c.capacity = 0;
+    c.values = nullptr;
+    c.words = nullptr;
+    return c;
+}
+
+// Append a container with the highest key so far (takes ownership)
+void CompressedBitmap::appendContainer(Container& c) {
+    Container& slot = insertContainer(count, c.key);
+    slot = c;
+}
+
+bool CompressedBitmap::containerContains(const Container& c, unsigned short value) {
+    if (c.type == BITSET) return (c.words[value >> 6] >> (value & 63)) & 1ULL;
+
+    if (c.type == ARRAY) {
+        int lo = 0, hi = c.size - 1;
+        while (lo <= hi) {
+            int mid = (lo + hi) / 2;
+            if (c.values[mid] == value) return true;
+            if (c.values[mid] < value) lo = mid + 1;
+            else hi = mid - 1;
+        }
+        return false;
+    }
+
+    // Last run starting at or before value
+    int lo = 0, hi = c.size - 1, found = -1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        if (c.values[2 * mid] <= value) {
+            found = mid;
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return found >= 0 && value <= (int)c.values[2 * found] + c.values[2 * found + 1];
+}
+
+void CompressedBitmap::orInto(const Container& c, unsigned long long* words) {
+    if (c.type == BITSET) {
+        for (int i = 0; i < BITSET_WORDS; i++) words[i] |= c.words[i];
+    } else if (c.type == ARRAY) {
+        for (int i = 0; i < c.size; i++) words[c.values[i] >> 6] |= 1ULL << (c.values[i] & 63);
+    } else {
+        for (int i = 0; i < c.size; i++) {
+            setRange(words, c.values[2 * i], c.values[2 * i] + c.values[2 * i + 1]);
+        }
+    }
+}
+
+// Smallest container holding the bits of words (cardinality 0 if none are set)
+CompressedBitmap::Container CompressedBitmap::fromWords(unsigned short key, const unsigned long long* words) {
+    Container c;
+    c.key = key;
+    c.type = ARRAY;
+    c.cardinality = 0;
+    c.size = 0;
+    c.capacity = 0;
+    c.values = nullptr;
+    c.words = nullptr;
+
+    // A run starts at every set bit whose lower neighbour is clear
+    int runs = 0;
+    unsigned long long carry = 0;
+    for (int i = 0; i < BITSET_WORDS; i++) {
+        unsigned long long w = words[i];
+        c.cardinality += bitCount(w);
+        runs += bitCount(w & ~((w << 1) | carry));
+        carry = w >> 63;
+    }
+    if (c.cardinality == 0) return c;
+
+    long long arrayBytes = c.cardinality <= ARRAY_MAX ? 2LL * c.cardinality : 1LL << 62;
+    long long bitsetBytes = 8LL * BITSET_WORDS;
+    long long runBytes = 4LL * runs;
+
+    if (runBytes < arrayBytes && runBytes < bitsetBytes) {
+        c.type = RUN;
+        c.size = c.capacity = runs;
+        c.values = new unsigned short[2 * runs];
+        int r = 0;
+        int i = 0;
+        unsigned long long w = words[0];
+        while (true) {
+            while (w == 0 && ++i < BITSET_WORDS) w = words[i];
+            if (i == BITSET_WORDS) break;
+            int start = i * 64 + __builtin_ctzll(w);
+
+            // Fill the zeros below the run, then follow the ones upwards
+            unsigned long long filled = w | (w - 1);
+            while (filled == ~0ULL && ++i < BITSET_WORDS) filled = words[i];
+            int end = i == BITSET_WORDS ? 65536 : i * 64 + __builtin_ctzll(~filled);
+            c.values[2 * r] = (unsigned short)start;
+            c.values[2 * r + 1] = (unsigned short)(end - 1 - start);
+            r++;
+            if (i == BITSET_WORDS) break;
+            w = filled & (filled + 1);     // drop the run
+        }
+    } else if (arrayBytes <= bitsetBytes) {
+        c.size = c.capacity = c.cardinality;
+        c.values = new unsigned short[c.cardinality];
+        int n = 0;
+        for (int i = 0; i < BITSET_WORDS; i++) {
+            unsigned long long w = words[i];
+            while (w) {
+                c.values[n++] = (unsigned short)(i * 64 + __builtin_ctzll(w));
+                w &= w - 1;
+            }
+        }
+    } else {
+        c.type = BITSET;
+        c.words = new unsigned long long[BITSET_WORDS];
+        memcpy(c.words, words, sizeof(unsigned long long) * BITSET_WORDS);
+    }
+    return c;
+}
+
+void CompressedBitmap::addToContainer(Container& c, unsigned short value) {
+    if (c.type == BITSET) {
+        unsigned long long bit = 1ULL << (value & 63);
+        if (!(c.words[value >> 6] & bit)) {
+            c.words[value >> 6] |= bit;
+            c.cardinality++;
+        }
+        return;
+    }
+
+    if (c.type == RUN) {
+        // Rare (runs only come from optimize): rebuild through a bitset
+        unsigned long long words[BITSET_WORDS] = {0};
+        orInto(c, words);
+        words[value >> 6] |= 1ULL << (value & 63);
+        Container rebuilt = fromWords(c.key, words);
+        freeContainer(c);
+        c = rebuilt;
+        return;
+    }
+
+    // Array: append in the common (ascending) case, insert otherwise
+    int at = c.size;
+    if (c.size > 0 && c.values[c.size - 1] >= value) {
+        int lo = 0, hi = c.size - 1;
+        while (lo <= hi) {
+            int mid = (lo + hi) / 2;
+            if (c.values[mid] == value) return;
+            if (c.values[mid] < value) lo = mid + 1;
+            else hi = mid - 1;
+        }
+        at = lo;
+    }
+
+    if (c.size == ARRAY_MAX) {
+        c.words = new unsigned long long[BITSET_WORDS];
+        memset(c.words, 0, sizeof(unsigned long long) * BITSET_WORDS);
+        orInto(c, c.words);
+        delete[] c.values;
+        c.values = nullptr;
+        c.size = c.capacity = 0;
+        c.type = BITSET;
+        addToContainer(c, value);
+        return;
+    }
+
+    if (c.size == c.capacity) {
+        int bigger = c.capacity > 0 ? c.capacity * 2 : 4;
+        if (bigger > ARRAY_MAX) bigger = ARRAY_MAX;
+        unsigned short* grown = new unsigned short[bigger];
+        if (c.size > 0) memcpy(grown, c.values, sizeof(unsigned short) * c.size);
+        delete[] c.values;
+        c.values = grown;
+        c.capacity = bigger;
+    }
+    memmove(c.values + at + 1, c.values + at, sizeof(unsigned short) * (c.size - at));
+    c.values[at] = value;
+    c.size++;
+    c.cardinality++;
+}
+
+// Values of array container a that are (keep) or are not (!keep) in b
+CompressedBitmap::Container CompressedBitmap::filter(const Container& a, const Container& b, bool keep) {
+    Container c;
+    c.key = a.key;
+    c.type = ARRAY;
+    c.size = 0;
+    c.capacity = a.size;
+    c.values = new unsigned short[a.size > 0 ? a.size : 1];
+    c.words = nullptr;
+
+    if (b.type == ARRAY) {
+        // Merge of two sorted arrays
+        int j = 0;
+        for (int i = 0; i < a.size; i++) {
+            while (j < b.size && b.values[j] < a.values[i]) j++;
+            bool inB = j < b.size && b.values[j] == a.values[i];
+            if (inB == keep) c.values[c.size++] = a.values[i];
+        }
+    } else {
+        for (int i = 0; i < a.size; i++) {
+            if (containerContains(b, a.values[i]) == keep) c.values[c.size++] = a.values[i];
+        }
+    }
+    c.cardinality = c.size;
+    return c;
+}
+
+void CompressedBitmap::add(int id) {
+    if (id < 0) return;
+    unsigned short key = (unsigned short)(id >> 16);
+    unsigned short value = (unsigned short)(id & 0xFFFF);
+
+    if (count > 0 && containers[count - 1].key == key) {
+        addToContainer(containers[count - 1], value);
+        return;
+    }
+    int at = findContainer(key);
+    if (at < 0) {
+        insertContainer(-at - 1, key);
+        at = -at - 1;
+    }
+    addToContainer(containers[at], value);
+}
+
+bool CompressedBitmap::contains(int id) const {
+    if (id < 0) return false;
+    int at = findContainer((unsigned short)(id >> 16));
+    return at >= 0 && containerContains(containers[at], (unsigned short)(id & 0xFFFF));
+}
+
+bool CompressedBitmap::isEmpty() const {
+    return count == 0;
+}
+
+int CompressedBitmap::cardinality() const {
+    int total = 0;
+    for (int i = 0; i < count; i++) total += containers[i].cardinality;
+    return total;
+}
+
+void CompressedBitmap::optimize() {
+    unsigned long long* words = new unsigned long long[BITSET_WORDS];
+    for (int i = 0; i < count; i++) {
+        memset(words, 0, sizeof(unsigned long long) * BITSET_WORDS);
+        orInto(containers[i], words);
+        Container smallest = fromWords(containers[i].key, words);
+        freeContainer(containers[i]);
+        containers[i] = smallest;
+    }
+    delete[] words;
+}
+
+CompressedBitmap CompressedBitmap::intersect(const CompressedBitmap& a, const CompressedBitmap& b) {
+    CompressedBitmap result;
+    unsigned long long* wa = nullptr;
+    unsigned long long* wb = nullptr;
+    int i = 0, j = 0;
+    while (i < a.count && j < b.count) {
+        const Container& ca = a.containers[i];
+        const Container& cb = b.containers[j];
+        if (ca.key < cb.key) { i++; continue; }
+        if (cb.key < ca.key) { j++; continue; }
+
+        Container c;
+        if (ca.type == ARRAY) {
+            c = filter(ca, cb, true);
+        } else if (cb.type == ARRAY) {
+            c = filter(cb, ca, true);
+        } else {
+            if (wa == nullptr) {
+                wa = new unsigned long long[BITSET_WORDS];
+                wb = new unsigned long long[BITSET_WORDS];
+            }
+            memset(wa, 0, sizeof(unsigned long long) * BITSET_WORDS);
+            memset(wb, 0, sizeof(unsigned long long) * BITSET_WORDS);
+            orInto(ca, wa);
+            orInto(cb, wb);
+            for (int w = 0; w < BITSET_WORDS; w++) wa[w] &= wb[w];
+            c = fromWords(ca.key, wa);
+        }
+        if (c.cardinality > 0) result.appendContainer(c);
+        else freeContainer(c);
+        i++;
+        j++;
+    }
+    delete[] wa;
+    delete[] wb;
+    return result;
+}
+
+CompressedBitmap CompressedBitmap::unite(const CompressedBitmap& a, const CompressedBitmap& b) {
+    CompressedBitmap result;
+    unsigned long long* words = nullptr;
+    int i = 0, j = 0;
+    while (i < a.count || j < b.count) {
+        // Keys in only one operand are copied
+        if (j == b.count || (i < a.count && a.containers[i].key < b.containers[j].key)) {
+            Container c = copyContainer(a.containers[i++]);
+            result.appendContainer(c);
+            continue;
+        }
+        if (i == a.count || b.containers[j].key < a.containers[i].key) {
+            Container c = copyContainer(b.containers[j++]);
+            result.appendContainer(c);
+            continue;
+        }
+
+        const Container& ca = a.containers[i];
+        const Container& cb = b.containers[j];
+        Container c;
+        if (ca.type == ARRAY && cb.type == ARRAY && ca.size + cb.size <= ARRAY_MAX) {
+            // Merge of two sorted arrays
+            c.key = ca.key;
+            c.type = ARRAY;
+            c.capacity = ca.size + cb.size;
+            c.values = new unsigned short[c.capacity > 0 ? c.capacity : 1];
+            c.words = nullptr;
+            int x = 0, y = 0, n = 0;
+            while (x < ca.size || y < cb.size) {
+                if (y == cb.size || (x < ca.size && ca.values[x] < cb.values[y])) {
+                    c.values[n++] = ca.values[x++];
+                } else if (x == ca.size || cb.values[y] < ca.values[x]) {
+                    c.values[n++] = cb.values[y++];
+                } else {
+                    c.values[n++] = ca.values[x++];
+                    y++;
+                }
+            }
+            c.size = c.cardinality = n;
+        } else {
+            if (words == nullptr) words = new unsigned long long[BITSET_WORDS];
+            memset(words, 0, sizeof(unsigned long long) * BITSET_WORDS);
+            orInto(ca, words);
+            orInto(cb, words);
+            c = fromWords(ca.key, words);
+        }
+        result.appendContainer(c);
+        i++;
+        j++;
+    }
+    delete[] words;
+    return result;
+}
+
+CompressedBitmap CompressedBitmap::subtract(const CompressedBitmap& a, const CompressedBitmap& b) {
+    CompressedBitmap result;
+    unsigned long long* wa = nullptr;
+    unsigned long long* wb = nullptr;
+    int j = 0;
+    for (int i = 0; i < a.count; i++) {
+        const Container& ca = a.containers[i];
+        while (j < b.count && b.containers[j].key < ca.key) j++;
+
+        Container c;
+        if (j == b.count || b.containers[j].key != ca.key) {
+            c = copyContainer(ca);     // nothing to remove
+        } else if (ca.type == ARRAY) {
+            c = filter(ca, b.containers[j], false);
+        } else {
+            if (wa == nullptr) {
+                wa = new unsigned long long[BITSET_WORDS];
+                wb = new unsigned long long[BITSET_WORDS];
+            }
+            memset(wa, 0, sizeof(unsigned long long) * BITSET_WORDS);
+            memset(wb, 0, sizeof(unsigned long long) * BITSET_WORDS);
+            orInto(ca, wa);
+            orInto(b.containers[j], wb);
+            for (int w = 0; w < BITSET_WORDS; w++) wa[w] &= ~wb[w];
+            c = fromWords(ca.key, wa);
+        }
+        if (c.cardinality > 0) result.appendContainer(c);
+        else freeContainer(c);
+    }
+    delete[] wa;
+    delete[] wb;
+    return result;
+}
+
+int CompressedBitmap::toArray(int* out, int max) const {
+    int n = 0;
+    for (int i = 0; i < count && n < max; i++) {
+        const Container& c = containers[i];
+        int high = (int)c.key << 16;
+        if (c.type == ARRAY) {
+            for (int k = 0; k < c.size && n < max; k++) out[n++] = high | c.values[k];
+        } else if (c.type == BITSET) {
+            for (int w = 0; w < BITSET_WORDS && n < max; w++) {
+                unsigned long long bits = c.words[w];
+                while (bits && n < max) {
+                    out[n++] = high | (w * 64 + __builtin_ctzll(bits));
+                    bits &= bits - 1;
+                }
+            }
+        } else {
+            for (int r = 0; r < c.size && n < max; r++) {
+                int start = c.values[2 * r], end = start + c.values[2 * r + 1];
+                for (int v = start; v <= end && n < max; v++) out[n++] = high | v;
+            }
+        }
+    }
+    return n;
+}
+
+long long CompressedBitmap::sizeInBytes() const {
+    long long bytes = (long long)sizeof(Container) * capacity;
+    for (int i = 0; i < count; i++) {
+        const Container& c = containers[i];
+        if (c.type == BITSET) bytes += 8LL * BITSET_WORDS;
+        else if (c.type == RUN) bytes += 4LL * c.capacity;
+        else bytes += 2LL * c.capacity;
+    }
+    return bytes;
+}
+
+void CompressedBitmap::containerCounts(int& arrays, int& bitsets, int& runs) const {
+    arrays = bitsets = runs = 0;
+    for (int i = 0; i < count; i++) {
+        if (containers[i].type == ARRAY) arrays++;
+        else if (containers[i].type == BITSET) bitsets++;
+        else runs++;
+    }
+}
@@ -0,0 +1,81 @@
+#ifndef COMPRESSEDBITMAP_HPP
+#define COMPRESSEDBITMAP_HPP
+
+// Compressed set of non-negative record ids (Roaring-style).
+// Ids are split into a 16-bit key (high bits) and a 16-bit value (low bits);
+// the values of each key live in one container, kept in the form that
+// takes the least space:
+//   array  - sorted values, for sparse chunks (at most 4096 values)
+//   bitset - 65536 bits, for dense chunks
+//   run    - sorted [start, start + length] ranges, for consecutive ids
+// Set operations work container by container and only look at keys present
+// in the operands, so a query over a few skills touches only their chunks.
+class CompressedBitmap {
+public:
+    static const int ARRAY_MAX = 4096;      // larger arrays become bitsets
+    static const int BITSET_WORDS = 1024;   // 65536 bits
+
+private:
+    enum ContainerType { ARRAY, BITSET, RUN };
+
+    struct Container {
+        unsigned short key;             // high 16 bits of the ids
+        unsigned char type;
+        int cardinality;
+        int size;                       // array: values, run: ranges
+        int capacity;
+        unsigned short* values;         // array values, or run (start, length) pairs
+        unsigned long long* words;      // bitset
+    };
+
+    Container* containers;      // sorted by key
+    int count;
+    int capacity;
+
+    int findContainer(unsigned short key) const;
+    Container& insertContainer(int at, unsigned short key);
+    void appendContainer(Container& c);
+    void clear();
+    void copyFrom(const CompressedBitmap& other);
+
+    static Container copyContainer(const Container& c);
+    static void freeContainer(Container& c);
+    static bool containerContains(const Container& c, unsigned short value);
+    static void addToContainer(Container& c, unsigned short value);
+    static void orInto(const Container& c, unsigned long long* words);
+    static Container fromWords(unsigned short key, const unsigned long long* words);
+    static Container filter(const Container& a, const Container& b, bool keep);
+
+public:
+    // Constructors & Destructor
+    CompressedBitmap();
+    ~CompressedBitmap();
+    CompressedBitmap(const CompressedBitmap& other);
+    CompressedBitmap(CompressedBitmap&& other) noexcept;
+    CompressedBitmap& operator=(const CompressedBitmap& other);
+    CompressedBitmap& operator=(CompressedBitmap&& other) noexcept;
+
+    // Add an id (negative ids are ignored). Cheapest in ascending order.
+    void add(int id);
+    bool contains(int id) const;
+    bool isEmpty() const;
+    int cardinality() const;
+
+    // Convert every container to its smallest form (after adding a batch)
+    void optimize();
+
+    // Set algebra
+    static CompressedBitmap intersect(const CompressedBitmap& a, const CompressedBitmap& b);
+    static CompressedBitmap unite(const CompressedBitmap& a, const CompressedBitmap& b);
+    static CompressedBitmap subtract(const CompressedBitmap& a, const CompressedBitmap& b);
+
+    // Up to max ids in ascending order; returns how many were written
+    int toArray(int* out, int max) const;
+
+    // Memory held by the containers
+    long long sizeInBytes() const;
+    // Containers of each kind (for reporting)
+    void containerCounts(int& arrays, int& bitsets, int& runs) const;
+};
+
+#endif
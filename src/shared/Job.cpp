@@ -1,42 +1,52 @@
 #include "Job.hpp"
+#include "StringPool.hpp"
 #include <iostream>
+#include <utility>
 
 // Default constructor
-Job::Job() : id(0), title(""), company(""), description(""), 
-             skillCount(0), experienceRequired(0) {}
+Job::Job() : id(0), title(StringPool::shared().intern("")), company(StringPool::shared().intern("")), 
+             description(), skillCount(0), experienceRequired(0) {}
 
-// Parameterized constructor
-Job::Job(int id, std::string title, std::string company, 
-         std::string description, int experienceRequired)
-    : id(id), title(title), company(company), description(description),
-      skillCount(0), experienceRequired(experienceRequired) {}
+// Parameterized constructor (title/company are interned, description gets a text source of its own)
+Job::Job(int id, const std::string& title, const std::string& company, 
+         const std::string& description, int experienceRequired)
+    : id(id), title(StringPool::shared().intern(title)), company(StringPool::shared().intern(company)),
+      description(description), skillCount(0), experienceRequired(experienceRequired) {}
 
 // Getters
 int Job::getId() const { return id; }
-std::string Job::getTitle() const { return title; }
-std::string Job::getCompany() const { return company; }
-std::string Job::getDescription() const { return description; }
+const std::string& Job::getTitle() const { return *title; }
+const std::string& Job::getCompany() const { return *company; }
+std::string Job::getDescription() const { return description.str(); }
 int Job::getExperienceRequired() const { return experienceRequired; }
 int Job::getSkillCount() const { return skillCount; }
 
-std::string Job::getSkill(int index) const {
+// Empty string returned for out-of-range skill indexes
+static const std::string NO_SKILL;
+
+const std::string& Job::getSkill(int index) const {
     if (index >= 0 && index < skillCount) {
-        return requiredSkills[index];
+        return *requiredSkills[index];
     }
-    return "";
+    return NO_SKILL;
+}
+
+SkillView Job::getSkills() const {
+    return SkillView(requiredSkills, skillCount);
 }
 
 // Setters
 void Job::setId(int id) { this->id = id; }
-void Job::setTitle(std::string title) { this->title = title; }
-void Job::setCompany(std::string company) { this->company = company; }
-void Job::setDescription(std::string description) { this->description = description; }
+void Job::setTitle(const std::string& title) { this->title = StringPool::shared().intern(title); }
+void Job::setCompany(const std::string& company) { this->company = StringPool::shared().intern(company); }
+void Job::setDescription(const std::string& description) { this->description = LazyText(description); }
+void Job::setDescription(LazyText description) { this->description = std::move(description); }
 void Job::setExperienceRequired(int years) { this->experienceRequired = years; }
 
 // Add a skill (max 10)
-bool Job::addSkill(std::string skill) {
+bool Job::addSkill(const std::string& skill) {
     if (skillCount < 10) {
-        requiredSkills[skillCount] = skill;
+        requiredSkills[skillCount] = StringPool::shared().intern(skill);
         skillCount++;
         return true;
     }
@@ -44,9 +54,9 @@ bool Job::addSkill(std::string skill) {
 }
 
 // Check if job requires a specific skill
-bool Job::hasSkill(std::string skill) const {
+bool Job::hasSkill(const std::string& skill) const {
     for (int i = 0; i < skillCount; i++) {
-        if (requiredSkills[i] == skill) {
+        if (*requiredSkills[i] == skill) {
             return true;
         }
     }
@@ -56,21 +66,21 @@ bool Job::hasSkill(std::string skill) const {
 // Display basic info
 void Job::display() const {
     std::cout << "Job ID: " << id << std::endl;
-    std::cout << "Title: " << title << std::endl;
-    std::cout << "Company: " << company << std::endl;
+    std::cout << "Title: " << *title << std::endl;
+    std::cout << "Company: " << *company << std::endl;
 }
 
 // Display detailed info
 void Job::displayDetailed() const {
     std::cout << "================================" << std::endl;
     std::cout << "Job ID: " << id << std::endl;
-    std::cout << "Title: " << title << std::endl;
-    std::cout << "Company: " << company << std::endl;
-    std::cout << "Description: " << description << std::endl;
+    std::cout << "Title: " << *title << std::endl;
+    std::cout << "Company: " << *company << std::endl;
+    std::cout << "Description: " << description.str() << std::endl;
     std::cout << "Experience Required: " << experienceRequired << " years" << std::endl;
     std::cout << "Required Skills: ";
     for (int i = 0; i < skillCount; i++) {
-        std::cout << requiredSkills[i];
+        std::cout << *requiredSkills[i];
         if (i < skillCount - 1) std::cout << ", ";
     }
     std::cout << std::endl;
@@ -2,42 +2,46 @@
 #define JOB_HPP
 
 #include <string>
+#include "SkillView.hpp"
+#include "TextSource.hpp"
 
 class Job {
 private:
     int id;
-    std::string title;
-    std::string company;
-    std::string description;
-    std::string requiredSkills[10];  // Max 10 skills
+    const std::string* title;       // interned in StringPool::shared()
+    const std::string* company;     // interned
+    LazyText description;           // materialized when read
+    const std::string* requiredSkills[10];  // Max 10 skills (interned)
     int skillCount;
     int experienceRequired;  // Years of experience
 
 public:
     // Constructors
     Job();
-    Job(int id, std::string title, std::string company, 
-        std::string description, int experienceRequired);
+    Job(int id, const std::string& title, const std::string& company, 
+        const std::string& description, int experienceRequired);
     
     // Getters
     int getId() const;
-    std::string getTitle() const;
-    std::string getCompany() const;
+    const std::string& getTitle() const;
+    const std::string& getCompany() const;
     std::string getDescription() const;
     int getExperienceRequired() const;
     int getSkillCount() const;
-    std::string getSkill(int index) const;
+    const std::string& getSkill(int index) const;
+    SkillView getSkills() const;
     
     // Setters
     void setId(int id);
-    void setTitle(std::string title);
-    void setCompany(std::string company);
-    void setDescription(std::string description);
+    void setTitle(const std::string& title);
+    void setCompany(const std::string& company);
+    void setDescription(const std::string& description);
+    void setDescription(LazyText description);      // e.g. a reference into a snapshot
     void setExperienceRequired(int years);
     
     // Skill management
-    bool addSkill(std::string skill);
-    bool hasSkill(std::string skill) const;
+    bool addSkill(const std::string& skill);
+    bool hasSkill(const std::string& skill) const;
     
     // Display
     void display() const;
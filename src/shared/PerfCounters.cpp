@@ -0,0 +1,198 @@
+#include "PerfCounters.hpp"
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+
+#ifdef __linux__
+#include <cerrno>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+const char* hwCounterName(int counter) {
+    switch (counter) {
+        case HW_CYCLES:        return "Cycles";
+        case HW_INSTRUCTIONS:  return "Instructions";
+        case HW_L1D_MISSES:    return "L1D Misses";
+        case HW_LLC_MISSES:    return "LLC Misses";
+        case HW_DTLB_MISSES:   return "dTLB Misses";
+        case HW_BRANCH_MISSES: return "Branch Misses";
+        default:               return "Unknown";
+    }
+}
+
+const char* perfPhaseName(int phase) {
+    switch (phase) {
+        case PHASE_LOAD:    return "Load";
+        case PHASE_EXTRACT: return "Extract";
+        case PHASE_MATCH:   return "Match";
+        case PHASE_SORT:    return "Sort";
+        case PHASE_TOPK:    return "Top-K";
+        default:            return "Unknown";
+    }
+}
+
+// CounterSample
+CounterSample::CounterSample() {
+    for (int c = 0; c < HW_COUNTER_COUNT; c++) values[c] = -1;
+}
+
+bool CounterSample::available() const {
+    for (int c = 0; c < HW_COUNTER_COUNT; c++) {
+        if (values[c] >= 0) return true;
+    }
+    return false;
+}
+
+void CounterSample::add(const CounterSample& other) {
+    for (int c = 0; c < HW_COUNTER_COUNT; c++) {
+        if (other.values[c] < 0) continue;
+        values[c] = (values[c] < 0) ? other.values[c] : values[c] + other.values[c];
+    }
+}
+
+double CounterSample::ipc() const {
+    if (values[HW_CYCLES] <= 0 || values[HW_INSTRUCTIONS] < 0) return -1;
+    return (double)values[HW_INSTRUCTIONS] / values[HW_CYCLES];
+}
+
+std::string formatCount(long long value) {
+    if (value < 0) return "n/a";
+    char buf[32];
+    if (value >= 1000000000LL) {
+        snprintf(buf, sizeof(buf), "%.2fG", value / 1e9);
+    } else if (value >= 1000000LL) {
+        snprintf(buf, sizeof(buf), "%.2fM", value / 1e6);
+    } else if (value >= 1000LL) {
+        snprintf(buf, sizeof(buf), "%.2fK", value / 1e3);
+    } else {
+        snprintf(buf, sizeof(buf), "%lld", value);
+    }
+    return buf;
+}
+
+// Events found missing once aren't tried again
+static std::atomic<bool> g_missing[HW_COUNTER_COUNT];
+static std::mutex g_statusLock;
+static std::string g_firstError;
+
+static void noteMissing(int counter, const char* reason) {
+    g_missing[counter].store(true);
+    std::lock_guard<std::mutex> guard(g_statusLock);
+    if (g_firstError.empty()) g_firstError = reason;
+}
+
+std::string hwCountersStatus() {
+    for (int c = 0; c < HW_COUNTER_COUNT; c++) {
+        if (!g_missing[c].load()) return "";
+    }
+    std::lock_guard<std::mutex> guard(g_statusLock);
+    return g_firstError;
+}
+
+#ifdef __linux__
+
+static void eventFor(int counter, perf_event_attr& attr) {
+    const unsigned long long read = PERF_COUNT_HW_CACHE_OP_READ << 8;
+    const unsigned long long miss = (unsigned long long)PERF_COUNT_HW_CACHE_RESULT_MISS << 16;
+    switch (counter) {
+        case HW_CYCLES:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CPU_CYCLES;
+            break;
+        case HW_INSTRUCTIONS:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+            break;
+        case HW_L1D_MISSES:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = PERF_COUNT_HW_CACHE_L1D | read | miss;
+            break;
+        case HW_LLC_MISSES:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CACHE_MISSES;
+            break;
+        case HW_DTLB_MISSES:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = PERF_COUNT_HW_CACHE_DTLB | read | miss;
+            break;
+        case HW_BRANCH_MISSES:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+            break;
+    }
+}
+
+CounterPhase::CounterPhase(bool enabled) {
+    for (int c = 0; c < HW_COUNTER_COUNT; c++) {
+        fds[c] = -1;
+        if (!enabled || g_missing[c].load()) continue;
+
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        eventFor(c, attr);
+        attr.disabled = 1;
+        attr.inherit = 1;               // include threads/processes started during the phase
+        attr.exclude_kernel = 1;        // allowed at perf_event_paranoid <= 2
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        int fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        if (fd < 0) {
+            char reason[128];
+            snprintf(reason, sizeof(reason), "perf_event_open: %s", strerror(errno));
+            noteMissing(c, reason);
+            continue;
+        }
+        fds[c] = fd;
+    }
+    for (int c = 0; c < HW_COUNTER_COUNT; c++) {
+        if (fds[c] < 0) continue;
+        ioctl(fds[c], PERF_EVENT_IOC_RESET, 0);
+        ioctl(fds[c], PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+CounterPhase::~CounterPhase() {
+    for (int c = 0; c < HW_COUNTER_COUNT; c++) {
+        if (fds[c] >= 0) close(fds[c]);
+    }
+}
+
+CounterSample CounterPhase::finish() {
+    CounterSample sample;
+    for (int c = 0; c < HW_COUNTER_COUNT; c++) {
+        if (fds[c] >= 0) ioctl(fds[c], PERF_EVENT_IOC_DISABLE, 0);
+    }
+    for (int c = 0; c < HW_COUNTER_COUNT; c++) {
+        if (fds[c] < 0) continue;
+        unsigned long long data[3];     // value, time enabled, time running
+        if (read(fds[c], data, sizeof(data)) == (ssize_t)sizeof(data)) {
+            double value = (double)data[0];
+            if (data[2] > 0 && data[2] < data[1]) value *= (double)data[1] / data[2];
+            sample.values[c] = (data[2] > 0 || data[0] > 0) ? (long long)value : -1;
+        }
+        close(fds[c]);
+        fds[c] = -1;
+    }
+    return sample;
+}
+
+#else
+
+CounterPhase::CounterPhase(bool) {
+    for (int c = 0; c < HW_COUNTER_COUNT; c++) {
+        fds[c] = -1;
+        noteMissing(c, "hardware counters need Linux perf_event_open");
+    }
+}
+
+CounterPhase::~CounterPhase() {}
+
+CounterSample CounterPhase::finish() { return CounterSample(); }
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef PERFCOUNTERS_HPP
+#define PERFCOUNTERS_HPP
+
+#include <string>
+
+// Hardware performance counters per phase, through Linux perf_event_open.
+//
+// A CounterPhase opens one counter per event for the calling thread
+// (user space only) and counts until finish(). Threads and processes it
+// starts during the phase are included. Events the CPU, kernel or
+// virtual machine doesn't provide read as -1 and print as "n/a"; on other
+// platforms every event is unavailable. Phases are meant to be
+// sequential, not nested.
+
+enum HwCounter {
+    HW_CYCLES,
+    HW_INSTRUCTIONS,
+    HW_L1D_MISSES,
+    HW_LLC_MISSES,
+    HW_DTLB_MISSES,
+    HW_BRANCH_MISSES,
+    HW_COUNTER_COUNT
+};
+
+const char* hwCounterName(int counter);
+
+struct CounterSample {
+    long long values[HW_COUNTER_COUNT];     // -1 = not available
+
+    CounterSample();
+    bool available() const;                  // at least one event counted
+    void add(const CounterSample& other);    // accumulate (e.g. jobs + resumes)
+    double ipc() const;                      // instructions per cycle, -1 if unknown
+};
+
+// Why counters are missing ("" when at least one event works)
+std::string hwCountersStatus();
+
+// "12.35M" style count, or "n/a"
+std::string formatCount(long long value);
+
+class CounterPhase {
+private:
+    int fds[HW_COUNTER_COUNT];
+
+public:
+    explicit CounterPhase(bool enabled = true);
+    ~CounterPhase();
+
+    CounterPhase(const CounterPhase&) = delete;
+    CounterPhase& operator=(const CounterPhase&) = delete;
+
+    // Stop counting and read the totals (scaled if the kernel multiplexed)
+    CounterSample finish();
+};
+
+// The phases both engines report
+enum PerfPhase {
+    PHASE_LOAD,         // reading CSV files or snapshots
+    PHASE_EXTRACT,      // building records / skill extraction
+    PHASE_MATCH,
+    PHASE_SORT,
+    PHASE_TOPK,
+    PHASE_COUNT
+};
+
+const char* perfPhaseName(int phase);
+
+struct PhaseCounters {
+    CounterSample phases[PHASE_COUNT];
+};
+
+#endif
@@ -0,0 +1,87 @@
+#include "Rcu.hpp"
+#include <functional>
+#include <thread>
+
+// Constructor
+EpochDomain::EpochDomain() : globalEpoch(1), retired(nullptr) {
+    for (int i = 0; i < MAX_READERS; i++) {
+        slots[i].epoch.store(0);
+        slots[i].used.store(false);
+    }
+}
+
+// Destructor
+EpochDomain::~EpochDomain() {
+    while (retired != nullptr) {
+        Retired* r = retired;
+        retired = r->next;
+        r->destroy(r->object);
+        delete r;
+    }
+}
+
+int EpochDomain::enter() {
+    // Claim a free slot, starting at a per-thread position to spread threads out
+    int start = (int)(std::hash<std::thread::id>()(std::this_thread::get_id()) % MAX_READERS);
+    for (;;) {
+        for (int k = 0; k < MAX_READERS; k++) {
+            int i = (start + k) % MAX_READERS;
+            bool expected = false;
+            if (!slots[i].used.load(std::memory_order_relaxed) &&
+                slots[i].used.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                // Announce the epoch before the caller loads any pointer
+                slots[i].epoch.store(globalEpoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+                return i;
+            }
+        }
+        std::this_thread::yield();      // more than MAX_READERS readers at once
+    }
+}
+
+void EpochDomain::exit(int slot) {
+    slots[slot].epoch.store(0, std::memory_order_release);
+    slots[slot].used.store(false, std::memory_order_release);
+}
+
+void EpochDomain::retire(void* object, void (*destroy)(void*)) {
+    std::lock_guard<std::mutex> guard(retireLock);
+    Retired* r = new Retired;
+    r->object = object;
+    r->destroy = destroy;
+    r->epoch = globalEpoch.fetch_add(1, std::memory_order_seq_cst) + 1;
+    r->next = retired;
+    retired = r;
+    reclaimLocked();
+}
+
+void EpochDomain::reclaim() {
+    std::lock_guard<std::mutex> guard(retireLock);
+    reclaimLocked();
+}
+
+void EpochDomain::reclaimLocked() {
+    unsigned long long oldest = 0;     // 0 = no active readers
+    for (int i = 0; i < MAX_READERS; i++) {
+        unsigned long long e = slots[i].epoch.load(std::memory_order_seq_cst);
+        if (e != 0 && (oldest == 0 || e < oldest)) oldest = e;
+    }
+
+    Retired** link = &retired;
+    while (*link != nullptr) {
+        Retired* r = *link;
+        if (oldest == 0 || oldest >= r->epoch) {
+            *link = r->next;
+            r->destroy(r->object);
+            delete r;
+        } else {
+            link = &r->next;
+        }
+    }
+}
+
+int EpochDomain::pending() {
+    std::lock_guard<std::mutex> guard(retireLock);
+    int n = 0;
+    for (Retired* r = retired; r != nullptr; r = r->next) n++;
+    return n;
+}
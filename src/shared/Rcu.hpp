@@ -0,0 +1,106 @@
+#ifndef RCU_HPP
+#define RCU_HPP
+
+#include <atomic>
+#include <mutex>
+
+// Read-copy-update publication with epoch-based reclamation.
+//
+// Data behind an RcuPtr is immutable once published. Readers enter a read
+// section (RcuReadGuard), load the pointer and use it for as long as the
+// guard lives; they never take a lock. A writer builds a new version off to
+// the side and publish()es it; the old version is retired and deleted once
+// no reader that might still see it is left in a read section.
+//
+// Every read section records the global epoch it started in. Publishing
+// advances the epoch after swapping the pointer, so readers that started in
+// the new epoch can only see the new version; a retired version is freed
+// when every active reader's epoch is at least the one it was retired in.
+
+class EpochDomain {
+public:
+    static const int MAX_READERS = 64;    // concurrent read sections
+
+private:
+    struct alignas(64) ReaderSlot {
+        std::atomic<unsigned long long> epoch;   // 0 = not reading
+        std::atomic<bool> used;
+    };
+
+    struct Retired {
+        void* object;
+        void (*destroy)(void*);
+        unsigned long long epoch;
+        Retired* next;
+    };
+
+    ReaderSlot slots[MAX_READERS];
+    std::atomic<unsigned long long> globalEpoch;
+    std::mutex retireLock;                // writers only
+    Retired* retired;
+
+    void reclaimLocked();
+
+public:
+    // Constructor & Destructor
+    EpochDomain();
+    ~EpochDomain();
+
+    EpochDomain(const EpochDomain&) = delete;
+    EpochDomain& operator=(const EpochDomain&) = delete;
+
+    // Start/end a read section; enter() returns the slot to pass to exit()
+    int enter();
+    void exit(int slot);
+
+    // Hand over an unpublished object; destroy(object) runs once it is safe
+    void retire(void* object, void (*destroy)(void*));
+
+    // Free whatever retired objects no reader can still see
+    void reclaim();
+
+    // Retired objects still waiting (for diagnostics)
+    int pending();
+};
+
+// Scope of a read section
+class RcuReadGuard {
+private:
+    EpochDomain& domain;
+    int slot;
+
+public:
+    explicit RcuReadGuard(EpochDomain& d) : domain(d), slot(d.enter()) {}
+    ~RcuReadGuard() { domain.exit(slot); }
+
+    RcuReadGuard(const RcuReadGuard&) = delete;
+    RcuReadGuard& operator=(const RcuReadGuard&) = delete;
+};
+
+// Atomically published pointer to an immutable T
+template <typename T>
+class RcuPtr {
+private:
+    std::atomic<T*> current;
+    EpochDomain& domain;
+
+    static void destroy(void* object) { delete static_cast<T*>(object); }
+
+public:
+    explicit RcuPtr(EpochDomain& d, T* initial = nullptr) : current(initial), domain(d) {}
+    ~RcuPtr() { delete current.load(); }
+
+    RcuPtr(const RcuPtr&) = delete;
+    RcuPtr& operator=(const RcuPtr&) = delete;
+
+    // Current version; stays valid while the guard is alive
+    const T* read(const RcuReadGuard&) const { return current.load(std::memory_order_seq_cst); }
+
+    // Swap in a new version and retire the old one
+    void publish(T* next) {
+        T* old = current.exchange(next, std::memory_order_seq_cst);
+        if (old != nullptr) domain.retire(old, &destroy);
+    }
+};
+
+#endif
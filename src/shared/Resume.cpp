@@ -1,42 +1,66 @@
 #include "Resume.hpp"
+#include "StringPool.hpp"
 #include <iostream>
+#include <utility>
 
 // Default constructor
-Resume::Resume() : id(0), name(""), email(""), summary(""), 
+Resume::Resume() : id(0), name(nullptr), email(nullptr), summary(), 
                    skillCount(0), yearsOfExperience(0) {}
 
-// Parameterized constructor
-Resume::Resume(int id, std::string name, std::string email, 
-               std::string summary, int yearsOfExperience)
-    : id(id), name(name), email(email), summary(summary),
+// Parameterized constructor (summary gets a text source of its own)
+Resume::Resume(int id, const std::string& name, const std::string& email, 
+               const std::string& summary, int yearsOfExperience)
+    : id(id), name(std::make_shared<const std::string>(name)), email(std::make_shared<const std::string>(email)),
+      summary(summary), skillCount(0), yearsOfExperience(yearsOfExperience) {}
+
+// Constructor for CSV candidates: name and email are generated from the id when needed
+Resume::Resume(int id, const std::string& summary, int yearsOfExperience)
+    : id(id), name(nullptr), email(nullptr), summary(summary),
       skillCount(0), yearsOfExperience(yearsOfExperience) {}
 
+// Generated contact details
+std::string Resume::candidateName(int id) {
+    return "Candidate_" + std::to_string(id);
+}
+
+std::string Resume::candidateEmail(int id) {
+    return "candidate" + std::to_string(id) + "@email.com";
+}
+
 // Getters
 int Resume::getId() const { return id; }
-std::string Resume::getName() const { return name; }
-std::string Resume::getEmail() const { return email; }
-std::string Resume::getSummary() const { return summary; }
+std::string Resume::getName() const { return name ? *name : candidateName(id); }
+std::string Resume::getEmail() const { return email ? *email : candidateEmail(id); }
+std::string Resume::getSummary() const { return summary.str(); }
 int Resume::getYearsOfExperience() const { return yearsOfExperience; }
 int Resume::getSkillCount() const { return skillCount; }
 
-std::string Resume::getSkill(int index) const {
+// Empty string returned for out-of-range skill indexes
+static const std::string NO_SKILL;
+
+const std::string& Resume::getSkill(int index) const {
     if (index >= 0 && index < skillCount) {
-        return skills[index];
+        return *skills[index];
     }
-    return "";
+    return NO_SKILL;
+}
+
+SkillView Resume::getSkills() const {
+    return SkillView(skills, skillCount);
 }
 
 // Setters
 void Resume::setId(int id) { this->id = id; }
-void Resume::setName(std::string name) { this->name = name; }
-void Resume::setEmail(std::string email) { this->email = email; }
-void Resume::setSummary(std::string summary) { this->summary = summary; }
+void Resume::setName(const std::string& name) { this->name = std::make_shared<const std::string>(name); }
+void Resume::setEmail(const std::string& email) { this->email = std::make_shared<const std::string>(email); }
+void Resume::setSummary(const std::string& summary) { this->summary = LazyText(summary); }
+void Resume::setSummary(LazyText summary) { this->summary = std::move(summary); }
 void Resume::setYearsOfExperience(int years) { this->yearsOfExperience = years; }
 
 // Add a skill (max 20)
-bool Resume::addSkill(std::string skill) {
+bool Resume::addSkill(const std::string& skill) {
     if (skillCount < 20) {
-        skills[skillCount] = skill;
+        skills[skillCount] = StringPool::shared().intern(skill);
         skillCount++;
         return true;
     }
@@ -44,33 +68,51 @@ bool Resume::addSkill(std::string skill) {
 }
 
 // Check if candidate has a specific skill
-bool Resume::hasSkill(std::string skill) const {
+bool Resume::hasSkill(const std::string& skill) const {
     for (int i = 0; i < skillCount; i++) {
-        if (skills[i] == skill) {
+        if (*skills[i] == skill) {
             return true;
         }
     }
     return false;
 }
 
+// Compare against the stored name, or parse "Candidate_<id>" without building it
+bool Resume::hasName(const std::string& other) const {
+    if (name != nullptr) return *name == other;
+    
+    static const std::string prefix = "Candidate_";
+    if (other.size() <= prefix.size() || other.compare(0, prefix.size(), prefix) != 0) return false;
+    
+    long long value = 0;
+    for (size_t i = prefix.size(); i < other.size(); i++) {
+        if (other[i] < '0' || other[i] > '9') return false;
+        if (i > prefix.size() && value == 0) return false;   // no leading zeros
+        value = value * 10 + (other[i] - '0');
+        if (value > 2147483647LL) return false;
+    }
+    if (id < 0) return false;
+    return value == id;
+}
+
 // Display basic info
 void Resume::display() const {
     std::cout << "Resume ID: " << id << std::endl;
-    std::cout << "Name: " << name << std::endl;
-    std::cout << "Email: " << email << std::endl;
+    std::cout << "Name: " << getName() << std::endl;
+    std::cout << "Email: " << getEmail() << std::endl;
 }
 
 // Display detailed info
 void Resume::displayDetailed() const {
     std::cout << "================================" << std::endl;
     std::cout << "Resume ID: " << id << std::endl;
-    std::cout << "Name: " << name << std::endl;
-    std::cout << "Email: " << email << std::endl;
-    std::cout << "Summary: " << summary << std::endl;
+    std::cout << "Name: " << getName() << std::endl;
+    std::cout << "Email: " << getEmail() << std::endl;
+    std::cout << "Summary: " << summary.str() << std::endl;
     std::cout << "Years of Experience: " << yearsOfExperience << std::endl;
     std::cout << "Skills: ";
     for (int i = 0; i < skillCount; i++) {
-        std::cout << skills[i];
+        std::cout << *skills[i];
         if (i < skillCount - 1) std::cout << ", ";
     }
     std::cout << std::endl;
@@ -1,43 +1,57 @@
 #ifndef RESUME_HPP
 #define RESUME_HPP
 
+#include <memory>
 #include <string>
+#include "SkillView.hpp"
+#include "TextSource.hpp"
 
 class Resume {
 private:
     int id;
-    std::string name;
-    std::string email;
-    std::string summary;
-    std::string skills[20];  // Max 20 skills
+    // Unique per record, so owned rather than interned; copies share them
+    std::shared_ptr<const std::string> name;    // nullptr: derived from id (see candidateName)
+    std::shared_ptr<const std::string> email;   // nullptr: derived from id (see candidateEmail)
+    LazyText summary;               // materialized when read
+    const std::string* skills[20];  // Max 20 skills (interned in StringPool::shared())
     int skillCount;
     int yearsOfExperience;
 
 public:
     // Constructors
     Resume();
-    Resume(int id, std::string name, std::string email, 
-           std::string summary, int yearsOfExperience);
+    Resume(int id, const std::string& name, const std::string& email, 
+           const std::string& summary, int yearsOfExperience);
+    Resume(int id, const std::string& summary, int yearsOfExperience);  // generated name/email
     
     // Getters
     int getId() const;
-    std::string getName() const;
+    std::string getName() const;     // generated on demand unless set explicitly
     std::string getEmail() const;
     std::string getSummary() const;
     int getYearsOfExperience() const;
     int getSkillCount() const;
-    std::string getSkill(int index) const;
+    const std::string& getSkill(int index) const;
+    SkillView getSkills() const;
     
     // Setters
     void setId(int id);
-    void setName(std::string name);
-    void setEmail(std::string email);
-    void setSummary(std::string summary);
+    void setName(const std::string& name);
+    void setEmail(const std::string& email);
+    void setSummary(const std::string& summary);
+    void setSummary(LazyText summary);              // e.g. a reference into a snapshot
     void setYearsOfExperience(int years);
     
     // Skill management
-    bool addSkill(std::string skill);
-    bool hasSkill(std::string skill) const;
+    bool addSkill(const std::string& skill);
+    bool hasSkill(const std::string& skill) const;
+    
+    // Name comparison without generating the name
+    bool hasName(const std::string& name) const;
+    
+    // Generated contact details for candidates loaded from the CSV
+    static std::string candidateName(int id);
+    static std::string candidateEmail(int id);
     
     // Display
     void display() const;
@@ -0,0 +1,293 @@
+#ifndef SCORINGCORE_HPP
+#define SCORINGCORE_HPP
+
+// Header-only scoring core shared by both implementations.
+// Every engine picks a policy type at compile time; the policy supplies the
+// weights, the experience curve and how empty skill sets are handled, so the
+// calls below inline into each engine's matching loop with no branching on
+// the policy itself.
+
+// Scoring used by the array implementation (70% skills / 30% experience,
+// linear experience curve, fixed scores when a side has no skills)
+struct ArrayScoringPolicy {
+    static const int SKILL_WEIGHT = 70;
+    static const int EXPERIENCE_WEIGHT = 30;
+
+    static inline bool emptySkillScore(int jobSkills, int resumeSkills, double& score) {
+        if (resumeSkills == 0 && jobSkills == 0) { score = 50.0; return true; }
+        if (jobSkills == 0) { score = 30.0; return true; }
+        if (resumeSkills == 0) { score = 20.0; return true; }
+        return false;
+    }
+
+    static inline double skillScore(int overlap, int jobSkills) {
+        return (100.0 * overlap) / (double)jobSkills;
+    }
+
+    static inline double experienceScore(int required, int actual) {
+        double expScore = 100.0;
+        if (actual < required) {
+            expScore = (actual * 100.0) / required;
+            if (expScore < 0) expScore = 0;
+        }
+        return expScore;
+    }
+
+    static inline double combine(double skillScore, double expScore) {
+        return (skillScore * 0.7) + (expScore * 0.3);
+    }
+
+    // Integer forms for the fixed-point scores: emptySkillScore in
+    // hundredths, and the skill/experience scores as exact fractions of 100
+    static inline bool emptySkillHundredths(int jobSkills, int resumeSkills, int& score) {
+        if (resumeSkills == 0 && jobSkills == 0) { score = 5000; return true; }
+        if (jobSkills == 0) { score = 3000; return true; }
+        if (resumeSkills == 0) { score = 2000; return true; }
+        return false;
+    }
+
+    static inline void skillFraction(int overlap, int jobSkills, int& num, int& den) {
+        num = overlap;
+        den = jobSkills;
+    }
+
+    static inline void experienceFraction(int required, int actual, int& num, int& den) {
+        if (actual >= required) { num = 1; den = 1; }
+        else { num = actual; den = required; }
+    }
+};
+
+// Scoring used by the linked list implementation (60% skills / 40% experience,
+// bonus for exceeding the requirement, no special case for empty skill sets)
+struct LinkedListScoringPolicy {
+    static const int SKILL_WEIGHT = 60;
+    static const int EXPERIENCE_WEIGHT = 40;
+
+    static inline bool emptySkillScore(int, int, double&) {
+        return false;
+    }
+
+    static inline double skillScore(int overlap, int jobSkills) {
+        if (jobSkills > 0) {
+            return (static_cast<double>(overlap) / jobSkills) * 100.0;
+        }
+        return 0.0;
+    }
+
+    static inline double experienceScore(int required, int actual) {
+        if (required == 0) {
+            return 100.0;
+        }
+
+        if (actual >= required) {
+            double ratio = static_cast<double>(actual) / required;
+            return (ratio >= 2.0) ? 100.0 : 50.0 + (ratio * 50.0);
+        } else {
+            return (static_cast<double>(actual) / required) * 100.0;
+        }
+    }
+
+    static inline double combine(double skillScore, double expScore) {
+        return (skillScore * SKILL_WEIGHT / 100.0) +
+               (expScore * EXPERIENCE_WEIGHT / 100.0);
+    }
+
+    static inline bool emptySkillHundredths(int, int, int&) {
+        return false;
+    }
+
+    static inline void skillFraction(int overlap, int jobSkills, int& num, int& den) {
+        if (jobSkills > 0) { num = overlap; den = jobSkills; }
+        else { num = 0; den = 1; }
+    }
+
+    static inline void experienceFraction(int required, int actual, int& num, int& den) {
+        if (required == 0 || actual >= 2 * required) { num = 1; den = 1; }
+        else if (actual >= required) { num = required + actual; den = 2 * required; }   // 50 + 50 * ratio
+        else { num = actual; den = required; }
+    }
+};
+
+template <typename Policy>
+struct ScoringCore {
+    // Final score (0-100) from the skill overlap and experience of a pair
+    static inline double score(int overlap, int jobSkills, int resumeSkills, int required, int actual) {
+        double fixed;
+        if (Policy::emptySkillScore(jobSkills, resumeSkills, fixed)) return fixed;
+
+        return Policy::combine(Policy::skillScore(overlap, jobSkills),
+                               Policy::experienceScore(required, actual));
+    }
+
+    // Same, for callers that already have the experience score
+    static inline double scoreWithExperience(int overlap, int jobSkills, int resumeSkills, double expScore) {
+        double fixed;
+        if (Policy::emptySkillScore(jobSkills, resumeSkills, fixed)) return fixed;
+
+        return Policy::combine(Policy::skillScore(overlap, jobSkills), expScore);
+    }
+
+    static inline double experienceScore(int required, int actual) {
+        return Policy::experienceScore(required, actual);
+    }
+
+    // Score in hundredths of a point (0-10000), computed exactly in integers
+    // and rounded half to even, as printf("%.2f") rounds a score that is
+    // exactly on a half. Equal scores compare equal whatever the engine, so
+    // ties are always decided by record order. Years and skill counts are
+    // expected to be non-negative; negative values count as 0.
+    //
+    // This matches the printed double score except on exact halves that the
+    // double doesn't hold exactly (only x.xx5 values that are multiples of
+    // 1/8 are exact in binary): those print on whichever side the double's
+    // rounding error falls, which no rule on the exact fraction can follow.
+    static inline int scoreHundredths(int overlap, int jobSkills, int resumeSkills, int required, int actual) {
+        int fixed;
+        if (Policy::emptySkillHundredths(jobSkills, resumeSkills, fixed)) return fixed;
+
+        int sn, sd, en, ed;
+        Policy::skillFraction(overlap < 0 ? 0 : overlap, jobSkills, sn, sd);
+        Policy::experienceFraction(required < 0 ? 0 : required, actual < 0 ? 0 : actual, en, ed);
+
+        // 100 * (SKILL_WEIGHT * sn/sd + EXPERIENCE_WEIGHT * en/ed) = num / den
+        long long num = 100LL * Policy::SKILL_WEIGHT * sn * ed + 100LL * Policy::EXPERIENCE_WEIGHT * en * sd;
+        long long den = (long long)sd * ed;
+        long long q = num / den, twice = 2 * (num % den);
+        if (twice > den || (twice == den && (q & 1))) q++;
+        return (int)q;
+    }
+
+    // Number of items of a that also appear in b
+    template <typename T>
+    static inline int countOverlap(const T* a, int aCount, const T* b, int bCount) {
+        int count = 0;
+        for (int i = 0; i < aCount; i++) {
+            for (int j = 0; j < bCount; j++) {
+                if (a[i] == b[j]) {
+                    count++;
+                    break;
+                }
+            }
+        }
+        return count;
+    }
+};
+
+// Precomputed score terms for one policy. Years of experience and skill
+// counts are small integers, so the experience curve is tabulated per
+// (required, actual) pair and the skill term per (job skill count, overlap);
+// the hot loop then does two loads instead of divisions and branches.
+// Entries are produced by the policy itself, so lookups are bit-identical to
+// the direct computation. Values outside the tables fall back to the policy.
+template <typename Policy>
+struct ScoreTables {
+    static const int MAX_YEARS = 31;
+    static const int MAX_SKILLS = 64;
+
+    double experience[MAX_YEARS + 1][MAX_YEARS + 1];   // [required][actual]
+    double skill[MAX_SKILLS + 1][MAX_SKILLS + 1];      // [jobSkills][overlap], jobSkills >= 1
+
+    ScoreTables() {
+        for (int r = 0; r <= MAX_YEARS; r++) {
+            for (int a = 0; a <= MAX_YEARS; a++) {
+                experience[r][a] = Policy::experienceScore(r, a);
+            }
+        }
+        for (int o = 0; o <= MAX_SKILLS; o++) skill[0][o] = 0.0;  // never read
+        for (int n = 1; n <= MAX_SKILLS; n++) {
+            for (int o = 0; o <= MAX_SKILLS; o++) {
+                skill[n][o] = (o <= n) ? Policy::skillScore(o, n) : 0.0;  // o > n never read
+            }
+        }
+    }
+
+    inline double experienceScore(int required, int actual) const {
+        if ((unsigned)required <= (unsigned)MAX_YEARS && (unsigned)actual <= (unsigned)MAX_YEARS) {
+            return experience[required][actual];
+        }
+        return Policy::experienceScore(required, actual);
+    }
+
+    inline double skillScore(int overlap, int jobSkills) const {
+        if (jobSkills > 0 && jobSkills <= MAX_SKILLS && (unsigned)overlap <= (unsigned)jobSkills) {
+            return skill[jobSkills][overlap];
+        }
+        return Policy::skillScore(overlap, jobSkills);
+    }
+
+    // Same result as ScoringCore<Policy>::score
+    inline double score(int overlap, int jobSkills, int resumeSkills, int required, int actual) const {
+        double fixed;
+        if (Policy::emptySkillScore(jobSkills, resumeSkills, fixed)) return fixed;
+
+        return Policy::combine(skillScore(overlap, jobSkills), experienceScore(required, actual));
+    }
+
+    // Same result as ScoringCore<Policy>::scoreWithExperience
+    inline double scoreWithExperience(int overlap, int jobSkills, int resumeSkills, double expScore) const {
+        double fixed;
+        if (Policy::emptySkillScore(jobSkills, resumeSkills, fixed)) return fixed;
+
+        return Policy::combine(skillScore(overlap, jobSkills), expScore);
+    }
+};
+
+// Fixed-point counterpart of ScoreTables: scores in hundredths, small
+// enough for 16-bit lanes. The skill and experience terms are tabulated in
+// units of 2^-14 hundredths, rounded up, so their sum is at most 2^-13 above
+// the exact score. Inside the tables the exact score is a fraction with a
+// denominator of at most 64 * 62, whose distance to the next rounding
+// boundary is either 0 or at least 1/7936 (more than 2 units). A sum less
+// than 2 units past a half is therefore an exact half and rounds to even,
+// so the result is the same as ScoringCore<Policy>::scoreHundredths.
+template <typename Policy>
+struct FixedScoreTables {
+    static const int MAX_YEARS = 31;
+    static const int MAX_SKILLS = 64;
+    static const int FRACTION_BITS = 14;
+
+    int experience[MAX_YEARS + 1][MAX_YEARS + 1];   // [required][actual]
+    int skill[MAX_SKILLS + 1][MAX_SKILLS + 1];      // [jobSkills][overlap]
+
+    // weight * num/den points, in units of 2^-FRACTION_BITS hundredths, rounded up
+    static int termUnits(int weight, int num, int den) {
+        long long scaled = (100LL * weight * num) << FRACTION_BITS;
+        return (int)((scaled + den - 1) / den);
+    }
+
+    FixedScoreTables() {
+        int num, den;
+        for (int r = 0; r <= MAX_YEARS; r++) {
+            for (int a = 0; a <= MAX_YEARS; a++) {
+                Policy::experienceFraction(r, a, num, den);
+                experience[r][a] = termUnits(Policy::EXPERIENCE_WEIGHT, num, den);
+            }
+        }
+        for (int o = 0; o <= MAX_SKILLS; o++) skill[0][o] = 0;  // no job skills: skill term 0
+        for (int n = 1; n <= MAX_SKILLS; n++) {
+            for (int o = 0; o <= MAX_SKILLS; o++) {
+                Policy::skillFraction(o <= n ? o : n, n, num, den);   // o > n never read
+                skill[n][o] = termUnits(Policy::SKILL_WEIGHT, num, den);
+            }
+        }
+    }
+
+    // Same result as ScoringCore<Policy>::scoreHundredths
+    inline short score(int overlap, int jobSkills, int resumeSkills, int required, int actual) const {
+        int fixed;
+        if (Policy::emptySkillHundredths(jobSkills, resumeSkills, fixed)) return (short)fixed;
+
+        if ((unsigned)required <= (unsigned)MAX_YEARS && (unsigned)actual <= (unsigned)MAX_YEARS &&
+            (unsigned)jobSkills <= (unsigned)MAX_SKILLS && (unsigned)overlap <= (unsigned)jobSkills) {
+            const int HALF = 1 << (FRACTION_BITS - 1);
+            int units = skill[jobSkills][overlap] + experience[required][actual];
+            int q = units >> FRACTION_BITS;
+            int rest = units & ((1 << FRACTION_BITS) - 1);
+            if (rest >= HALF + 2 || (rest >= HALF && (q & 1))) q++;
+            return (short)q;
+        }
+        return (short)ScoringCore<Policy>::scoreHundredths(overlap, jobSkills, resumeSkills, required, actual);
+    }
+};
+
+#endif
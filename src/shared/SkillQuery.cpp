@@ -0,0 +1,223 @@
+#include "SkillQuery.hpp"
+#include <cctype>
+#include <utility>
+
+static std::string lowercase(const std::string& s) {
+    std::string out = s;
+    for (size_t i = 0; i < out.size(); i++) out[i] = (char)tolower((unsigned char)out[i]);
+    return out;
+}
+
+// SkillQueryIndex
+SkillQueryIndex::SkillQueryIndex() : skillTotal(0) {}
+
+int SkillQueryIndex::findSkill(const std::string& name) const {
+    std::string lower = lowercase(name);
+    for (int i = 0; i < skillTotal; i++) {
+        if (skillNames[i] == lower) return i;
+    }
+    return -1;
+}
+
+void SkillQueryIndex::addRecord(int id) {
+    allIds.add(id);
+}
+
+int SkillQueryIndex::defineSkill(const std::string& name) {
+    int s = findSkill(name);
+    if (s >= 0) return s;
+    if (skillTotal == MAX_SKILLS) return -1;
+    skillNames[skillTotal] = lowercase(name);
+    return skillTotal++;
+}
+
+void SkillQueryIndex::addSkill(int id, int skill) {
+    if (skill >= 0 && skill < skillTotal) skillIds[skill].add(id);
+}
+
+void SkillQueryIndex::addSkill(int id, const std::string& skill) {
+    addSkill(id, defineSkill(skill));
+}
+
+void SkillQueryIndex::finish() {
+    allIds.optimize();
+    for (int i = 0; i < skillTotal; i++) skillIds[i].optimize();
+}
+
+int SkillQueryIndex::recordCount() const { return allIds.cardinality(); }
+int SkillQueryIndex::skillCount() const { return skillTotal; }
+const std::string& SkillQueryIndex::skillName(int index) const { return skillNames[index]; }
+const CompressedBitmap& SkillQueryIndex::recordsWith(int index) const { return skillIds[index]; }
+
+long long SkillQueryIndex::sizeInBytes() const {
+    long long bytes = allIds.sizeInBytes();
+    for (int i = 0; i < skillTotal; i++) bytes += skillIds[i].sizeInBytes();
+    return bytes;
+}
+
+// Query evaluation (recursive descent, one bitmap per subexpression)
+//   expr   := term { OR term }
+//   term   := factor { AND [NOT] factor }
+//   factor := NOT factor | '(' expr ')' | name
+namespace {
+
+enum TokenType { TOKEN_END, TOKEN_NAME, TOKEN_AND, TOKEN_OR, TOKEN_NOT, TOKEN_OPEN, TOKEN_CLOSE, TOKEN_BAD };
+
+struct Token {
+    TokenType type;
+    std::string text;       // skill word(s) for TOKEN_NAME
+    size_t start;
+    bool quoted;
+};
+
+class QueryParser {
+private:
+    const SkillQueryIndex& index;
+    const CompressedBitmap& all;
+    const std::string& text;
+    size_t pos;
+
+    Token read() {
+        while (pos < text.size() && isspace((unsigned char)text[pos])) pos++;
+        Token t;
+        t.start = pos;
+        t.quoted = false;
+        if (pos == text.size()) {
+            t.type = TOKEN_END;
+            return t;
+        }
+
+        char c = text[pos];
+        if (c == '(') { pos++; t.type = TOKEN_OPEN; return t; }
+        if (c == ')') { pos++; t.type = TOKEN_CLOSE; return t; }
+        if (c == '&') { pos++; t.type = TOKEN_AND; return t; }
+        if (c == '|') { pos++; t.type = TOKEN_OR; return t; }
+        if (c == '!') { pos++; t.type = TOKEN_NOT; return t; }
+        if (c == '"') {
+            size_t close = text.find('"', pos + 1);
+            if (close == std::string::npos) {
+                t.type = TOKEN_BAD;
+                t.text = "missing closing quote";
+                return t;
+            }
+            t.type = TOKEN_NAME;
+            t.quoted = true;
+            t.text = text.substr(pos + 1, close - pos - 1);
+            pos = close + 1;
+            return t;
+        }
+
+        size_t end = pos;
+        while (end < text.size() && !isspace((unsigned char)text[end]) &&
+               text[end] != '(' && text[end] != ')' && text[end] != '&' &&
+               text[end] != '|' && text[end] != '!' && text[end] != '"') {
+            end++;
+        }
+        t.text = text.substr(pos, end - pos);
+        pos = end;
+
+        std::string word = lowercase(t.text);
+        if (word == "and") t.type = TOKEN_AND;
+        else if (word == "or") t.type = TOKEN_OR;
+        else if (word == "not") t.type = TOKEN_NOT;
+        else t.type = TOKEN_NAME;
+        return t;
+    }
+
+    Token peek() {
+        size_t saved = pos;
+        Token t = read();
+        pos = saved;
+        return t;
+    }
+
+    bool fail(const std::string& message, size_t at) {
+        if (error.empty()) error = message + " (at position " + std::to_string(at + 1) + ")";
+        return false;
+    }
+
+    bool parseFactor(CompressedBitmap& out) {
+        Token t = read();
+        if (t.type == TOKEN_NOT) {
+            CompressedBitmap inner;
+            if (!parseFactor(inner)) return false;
+            out = CompressedBitmap::subtract(all, inner);
+            return true;
+        }
+        if (t.type == TOKEN_OPEN) {
+            if (!parseExpression(out)) return false;
+            Token close = read();
+            if (close.type != TOKEN_CLOSE) return fail("expected ')'", close.start);
+            return true;
+        }
+        if (t.type == TOKEN_BAD) return fail(t.text, t.start);
+        if (t.type != TOKEN_NAME) return fail("expected a skill", t.start);
+
+        // Consecutive unquoted words form one name ("machine learning")
+        std::string name = t.text;
+        while (!t.quoted) {
+            Token next = peek();
+            if (next.type != TOKEN_NAME || next.quoted) break;
+            name += " " + read().text;
+        }
+        int skill = index.findSkill(name);
+        if (skill < 0) return fail("unknown skill '" + name + "'", t.start);
+        out = index.recordsWith(skill);
+        return true;
+    }
+
+    bool parseTerm(CompressedBitmap& out) {
+        if (!parseFactor(out)) return false;
+        while (peek().type == TOKEN_AND) {
+            read();
+            // a AND NOT b is a - b; no need to complement b first
+            bool negate = false;
+            while (peek().type == TOKEN_NOT) {
+                read();
+                negate = !negate;
+            }
+            CompressedBitmap rhs;
+            if (!parseFactor(rhs)) return false;
+            out = negate ? CompressedBitmap::subtract(out, rhs) : CompressedBitmap::intersect(out, rhs);
+        }
+        return true;
+    }
+
+public:
+    std::string error;
+
+    QueryParser(const SkillQueryIndex& index, const CompressedBitmap& all, const std::string& text)
+        : index(index), all(all), text(text), pos(0) {}
+
+    bool parseExpression(CompressedBitmap& out) {
+        if (!parseTerm(out)) return false;
+        while (peek().type == TOKEN_OR) {
+            read();
+            CompressedBitmap rhs;
+            if (!parseTerm(rhs)) return false;
+            out = CompressedBitmap::unite(out, rhs);
+        }
+        return true;
+    }
+
+    bool parseAll(CompressedBitmap& out) {
+        if (!parseExpression(out)) return false;
+        Token t = read();
+        if (t.type != TOKEN_END) return fail("unexpected input", t.start);
+        return true;
+    }
+};
+
+} // namespace
+
+bool SkillQueryIndex::evaluate(const std::string& expression, CompressedBitmap& result,
+                               std::string& error) const {
+    QueryParser parser(*this, allIds, expression);
+    CompressedBitmap out;
+    if (!parser.parseAll(out)) {
+        error = parser.error;
+        return false;
+    }
+    result = std::move(out);
+    return true;
+}
@@ -0,0 +1,55 @@
+#ifndef SKILLQUERY_HPP
+#define SKILLQUERY_HPP
+
+#include <string>
+#include "CompressedBitmap.hpp"
+
+// Boolean skill queries over one record set (jobs or resumes).
+// Every skill keeps a compressed bitmap of the ids of the records that have
+// it, so a query is a few set operations on bitmaps instead of a walk over
+// the records comparing skill strings.
+//
+// Query syntax (case-insensitive):
+//   python AND sql AND NOT java
+//   aws OR azure OR gcp
+//   (machine learning OR deep learning) AND NOT excel
+// NOT binds tightest, then AND, then OR. &, | and ! may be used instead of
+// the words. A skill name is one or more words ("power bi"); names that
+// contain an operator word can be quoted ("problem solving").
+class SkillQueryIndex {
+public:
+    static const int MAX_SKILLS = 64;
+
+private:
+    std::string skillNames[MAX_SKILLS];     // lowercase
+    CompressedBitmap skillIds[MAX_SKILLS];
+    CompressedBitmap allIds;                // every record (NOT is taken against it)
+    int skillTotal;
+
+public:
+    SkillQueryIndex();
+
+    // Building: add every record and its skills, then call finish().
+    // Skills get indices in the order they are first seen; defining a
+    // vocabulary up front fixes them (and makes unused skills known).
+    int defineSkill(const std::string& name);           // -1 beyond MAX_SKILLS
+    void addRecord(int id);
+    void addSkill(int id, int skill);
+    void addSkill(int id, const std::string& skill);    // skills beyond MAX_SKILLS are ignored
+    void finish();
+
+    int recordCount() const;
+    int skillCount() const;
+    int findSkill(const std::string& name) const;       // any case; -1 if unknown
+    const std::string& skillName(int index) const;
+    const CompressedBitmap& recordsWith(int index) const;
+
+    // Ids of the records matching expression. Returns false (and a message
+    // in error) for a malformed expression or an unknown skill.
+    bool evaluate(const std::string& expression, CompressedBitmap& result, std::string& error) const;
+
+    // Memory held by the bitmaps
+    long long sizeInBytes() const;
+};
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef SKILLVIEW_HPP
+#define SKILLVIEW_HPP
+
+#include <string>
+
+// Read-only view over a record's skills (no copies). Skills are interned in
+// StringPool::shared(), so two skills are equal exactly when their pointers are.
+struct SkillView {
+    const std::string* const* data;
+    int count;
+    
+    SkillView(const std::string* const* data, int count) : data(data), count(count) {}
+    
+    int size() const { return count; }
+    const std::string& operator[](int i) const { return *data[i]; }
+};
+
+#endif
@@ -0,0 +1,338 @@
+#include "Snapshot.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sys/stat.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+static const char SNAPSHOT_MAGIC[8] = {'J', 'M', 'S', 'N', 'A', 'P', 0, 0};
+
+// FNV-1a, 64 bit
+static unsigned long long fnv1a(const void* data, unsigned long long length,
+                                unsigned long long h = 14695981039346656037ULL) {
+    const unsigned char* p = (const unsigned char*)data;
+    for (unsigned long long i = 0; i < length; i++) {
+        h ^= p[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+// ---------------------------------------------------------------------------
+// Snapshot helpers
+// ---------------------------------------------------------------------------
+
+unsigned long long Snapshot::sourceKey(const char* csvPath) {
+    struct stat st;
+    if (stat(csvPath, &st) != 0) return 0;
+
+    long long size = (long long)st.st_size;
+    long long mtime = (long long)st.st_mtime;
+    unsigned long long h = fnv1a(&size, sizeof(size));
+    h = fnv1a(&mtime, sizeof(mtime), h);
+
+    // Sample both ends of the file so in-place edits that keep size and
+    // timestamp (e.g. restored backups) still change the key
+    std::ifstream file(csvPath, std::ios::binary);
+    if (!file.is_open()) return 0;
+
+    const int SAMPLE = 64 * 1024;
+    char* buffer = new char[SAMPLE];
+    file.read(buffer, SAMPLE);
+    h = fnv1a(buffer, (unsigned long long)file.gcount(), h);
+    if (size > SAMPLE) {
+        file.clear();
+        file.seekg(size > 2 * SAMPLE ? size - SAMPLE : SAMPLE);
+        file.read(buffer, SAMPLE);
+        h = fnv1a(buffer, (unsigned long long)file.gcount(), h);
+    }
+    delete[] buffer;
+
+    return h == 0 ? 1 : h;
+}
+
+unsigned long long Snapshot::vocabularyKey(const char* const* skills, int count) {
+    unsigned long long h = fnv1a(&count, sizeof(count));
+    for (int i = 0; i < count; i++) {
+        h = fnv1a(skills[i], strlen(skills[i]) + 1, h);   // include the terminator as separator
+    }
+    return h;
+}
+
+unsigned long long Snapshot::vocabularyKey(const std::string* skills, int count) {
+    unsigned long long h = fnv1a(&count, sizeof(count));
+    for (int i = 0; i < count; i++) {
+        h = fnv1a(skills[i].c_str(), skills[i].size() + 1, h);
+    }
+    return h;
+}
+
+std::string Snapshot::pathFor(const char* csvPath, const char* engine) {
+    return std::string(csvPath) + "." + engine + ".snap";
+}
+
+// ---------------------------------------------------------------------------
+// SnapshotWriter
+// ---------------------------------------------------------------------------
+
+// Constructor
+SnapshotWriter::SnapshotWriter() : count(0), capacity(1024), textSize(0), textCapacity(64 * 1024) {
+    records = new SnapshotRecord[capacity];
+    text = new char[textCapacity];
+}
+
+// Destructor
+SnapshotWriter::~SnapshotWriter() {
+    delete[] records;
+    delete[] text;
+}
+
+// Append bytes to the text area and return their offset
+unsigned long long SnapshotWriter::appendText(const char* data, unsigned long long length) {
+    if (textSize + length > textCapacity) {
+        unsigned long long newCapacity = textCapacity * 2;
+        while (newCapacity < textSize + length) newCapacity *= 2;
+        char* bigger = new char[newCapacity];
+        memcpy(bigger, text, textSize);
+        delete[] text;
+        text = bigger;
+        textCapacity = newCapacity;
+    }
+
+    unsigned long long offset = textSize;
+    memcpy(text + textSize, data, length);
+    textSize += length;
+    return offset;
+}
+
+TextRef SnapshotWriter::add(int id, int years, unsigned long long skillMask,
+                            const std::string& title, const std::string& recordText) {
+    if (count == capacity) {
+        SnapshotRecord* bigger = new SnapshotRecord[capacity * 2];
+        memcpy(bigger, records, sizeof(SnapshotRecord) * count);
+        delete[] records;
+        records = bigger;
+        capacity *= 2;
+    }
+
+    SnapshotRecord& r = records[count++];
+    r.id = id;
+    r.years = years;
+    r.skillMask = skillMask;
+    r.textOffset = appendText(recordText.data(), recordText.size());
+    r.textLength = (unsigned int)recordText.size();
+
+    // Titles are usually a prefix of the text; only store them separately otherwise
+    if (title.size() <= recordText.size() && recordText.compare(0, title.size(), title) == 0) {
+        r.titleOffset = r.textOffset;
+    } else {
+        r.titleOffset = appendText(title.data(), title.size());
+    }
+    r.titleLength = (unsigned int)title.size();
+
+    TextRef ref;
+    ref.offset = r.textOffset;
+    ref.length = r.textLength;
+    return ref;
+}
+
+bool SnapshotWriter::write(const std::string& path, unsigned long long sourceKey,
+                           unsigned long long vocabularyKey) const {
+    if (sourceKey == 0) return false;
+
+    SnapshotHeader header;
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = Snapshot::VERSION;
+    header.recordCount = (unsigned int)count;
+    header.sourceKey = sourceKey;
+    header.vocabularyKey = vocabularyKey;
+    header.textSize = textSize;
+
+    std::string tmpPath = path + ".tmp";
+    std::ofstream out(tmpPath.c_str(), std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) return false;
+
+    out.write((const char*)&header, sizeof(header));
+    out.write((const char*)records, sizeof(SnapshotRecord) * count);
+    out.write(text, (std::streamsize)textSize);
+    out.close();
+    if (!out) {
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+
+    std::remove(path.c_str());   // rename() won't replace an existing file on Windows
+    return std::rename(tmpPath.c_str(), path.c_str()) == 0;
+}
+
+std::shared_ptr<const TextSource> SnapshotWriter::writeAndShareText(const std::string& path,
+                                                                    unsigned long long sourceKey,
+                                                                    unsigned long long vocabularyKey) {
+    if (write(path, sourceKey, vocabularyKey)) {
+        SnapshotReader reader;
+        if (reader.open(path, sourceKey, vocabularyKey) && reader.size() == count) {
+            return reader.shareText();
+        }
+    }
+
+    // No usable file: the records refer to the buffer itself
+    std::shared_ptr<const TextSource> source =
+        std::make_shared<const TextSource>(text, textCapacity, false, 0, textSize);
+    text = nullptr;
+    textCapacity = 0;
+    return source;
+}
+
+TextRef SnapshotWriter::textRef(int index) const {
+    TextRef ref;
+    ref.offset = records[index].textOffset;
+    ref.length = records[index].textLength;
+    return ref;
+}
+
+// ---------------------------------------------------------------------------
+// SnapshotReader
+// ---------------------------------------------------------------------------
+
+// Constructor
+SnapshotReader::SnapshotReader()
+    : base(nullptr), length(0), mapped(false), header(nullptr), records(nullptr), textArea(nullptr) {}
+
+// Destructor
+SnapshotReader::~SnapshotReader() {
+    close();
+}
+
+void SnapshotReader::close() {
+    if (shared) {
+        shared.reset();     // the source owns base now
+    } else if (base != nullptr) {
+#ifndef _WIN32
+        if (mapped) munmap(base, length);
+        else delete[] base;
+#else
+        delete[] base;
+#endif
+    }
+    base = nullptr;
+    length = 0;
+    mapped = false;
+    header = nullptr;
+    records = nullptr;
+    textArea = nullptr;
+}
+
+bool SnapshotReader::isOpen() const {
+    return header != nullptr;
+}
+
+bool SnapshotReader::open(const std::string& path, unsigned long long sourceKey,
+                          unsigned long long vocabularyKey) {
+    close();
+    if (sourceKey == 0) return false;
+
+#ifndef _WIN32
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(SnapshotHeader)) {
+        ::close(fd);
+        return false;
+    }
+    length = (unsigned long long)st.st_size;
+    void* p = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) {
+        length = 0;
+        return false;
+    }
+    base = (char*)p;
+    mapped = true;
+#else
+    std::ifstream in(path.c_str(), std::ios::binary | std::ios::ate);
+    if (!in.is_open()) return false;
+    length = (unsigned long long)in.tellg();
+    if (length < sizeof(SnapshotHeader)) return false;
+    base = new char[length];
+    in.seekg(0);
+    in.read(base, (std::streamsize)length);
+    if (!in) {
+        close();
+        return false;
+    }
+#endif
+
+    // Validate before exposing anything
+    const SnapshotHeader* h = (const SnapshotHeader*)base;
+    unsigned long long expected = sizeof(SnapshotHeader) +
+                                  (unsigned long long)h->recordCount * sizeof(SnapshotRecord) +
+                                  h->textSize;
+    if (memcmp(h->magic, SNAPSHOT_MAGIC, sizeof(h->magic)) != 0 ||
+        h->version != Snapshot::VERSION ||
+        h->sourceKey != sourceKey ||
+        h->vocabularyKey != vocabularyKey ||
+        expected != length) {
+        close();
+        return false;
+    }
+
+    const SnapshotRecord* r = (const SnapshotRecord*)(base + sizeof(SnapshotHeader));
+    for (unsigned int i = 0; i < h->recordCount; i++) {
+        if (r[i].textOffset + r[i].textLength > h->textSize ||
+            r[i].titleOffset + r[i].titleLength > h->textSize) {
+            close();
+            return false;
+        }
+    }
+
+    header = h;
+    records = r;
+    textArea = base + sizeof(SnapshotHeader) + (unsigned long long)h->recordCount * sizeof(SnapshotRecord);
+    return true;
+}
+
+int SnapshotReader::size() const {
+    return header ? (int)header->recordCount : 0;
+}
+
+const SnapshotRecord& SnapshotReader::record(int index) const {
+    return records[index];
+}
+
+const char* SnapshotReader::text(int index) const {
+    return textArea + records[index].textOffset;
+}
+
+const char* SnapshotReader::title(int index) const {
+    return textArea + records[index].titleOffset;
+}
+
+std::string SnapshotReader::textString(int index) const {
+    return std::string(textArea + records[index].textOffset, records[index].textLength);
+}
+
+std::string SnapshotReader::titleString(int index) const {
+    return std::string(textArea + records[index].titleOffset, records[index].titleLength);
+}
+
+TextRef SnapshotReader::textRef(int index) const {
+    TextRef ref;
+    ref.offset = records[index].textOffset;
+    ref.length = records[index].textLength;
+    return ref;
+}
+
+std::shared_ptr<const TextSource> SnapshotReader::shareText() {
+    if (!isOpen()) return std::make_shared<const TextSource>(std::string());
+    if (!shared) {
+        shared = std::make_shared<const TextSource>(base, length, mapped,
+                                                    (unsigned long long)(textArea - base),
+                                                    header->textSize);
+    }
+    return shared;
+}
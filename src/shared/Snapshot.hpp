@@ -0,0 +1,140 @@
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+
+#include "TextSource.hpp"
+#include <memory>
+#include <string>
+
+// Binary snapshot of parsed, skill-extracted records.
+// Written after the first CSV load and memory-mapped on later runs, so
+// startup skips tokenizing and skill extraction entirely.
+//
+// Layout (native endianness):
+//   SnapshotHeader
+//   SnapshotRecord[recordCount]
+//   text area (descriptions/summaries and titles, not NUL terminated)
+//
+// A snapshot is only used when its version, source key (fingerprint of the
+// CSV file) and vocabulary key (hash of the skill list that produced the
+// masks) all match; otherwise the caller reparses and rewrites it.
+
+struct SnapshotHeader {
+    char magic[8];                  // "JMSNAP\0\0"
+    unsigned int version;
+    unsigned int recordCount;
+    unsigned long long sourceKey;
+    unsigned long long vocabularyKey;
+    unsigned long long textSize;
+};
+
+struct SnapshotRecord {
+    int id;
+    int years;
+    unsigned long long skillMask;   // bit i = vocabulary skill i
+    unsigned long long textOffset;
+    unsigned long long titleOffset;
+    unsigned int textLength;
+    unsigned int titleLength;       // 0 when the record has no title
+};
+
+// Helpers shared by the writer and reader
+class Snapshot {
+public:
+    static const unsigned int VERSION = 1;
+
+    // Fingerprint of a CSV file: size, modification time and the bytes at
+    // both ends (0 if the file can't be read)
+    static unsigned long long sourceKey(const char* csvPath);
+
+    // Hash of a skill vocabulary, in order
+    static unsigned long long vocabularyKey(const char* const* skills, int count);
+    static unsigned long long vocabularyKey(const std::string* skills, int count);
+
+    // Snapshot file used for a CSV by one implementation ("array", "linkedlist")
+    static std::string pathFor(const char* csvPath, const char* engine);
+};
+
+// Collects records and writes them out
+class SnapshotWriter {
+private:
+    SnapshotRecord* records;
+    int count;
+    int capacity;
+    char* text;
+    unsigned long long textSize;
+    unsigned long long textCapacity;
+
+    unsigned long long appendText(const char* data, unsigned long long length);
+
+public:
+    // Constructor & Destructor
+    SnapshotWriter();
+    ~SnapshotWriter();
+
+    SnapshotWriter(const SnapshotWriter&) = delete;
+    SnapshotWriter& operator=(const SnapshotWriter&) = delete;
+
+    // Returns where the record's text is in the text area
+    TextRef add(int id, int years, unsigned long long skillMask,
+                const std::string& title, const std::string& text);
+
+    // Write to a temporary file and rename it into place
+    bool write(const std::string& path, unsigned long long sourceKey,
+               unsigned long long vocabularyKey) const;
+
+    // Where record index's text is in the text area
+    TextRef textRef(int index) const;
+
+    // write(), then return the text area for the records to refer to: the
+    // new file mapped again if it could be written, otherwise the buffer
+    // itself (no more records can be added afterwards)
+    std::shared_ptr<const TextSource> writeAndShareText(const std::string& path,
+                                                        unsigned long long sourceKey,
+                                                        unsigned long long vocabularyKey);
+};
+
+// Read-only, memory-mapped view of a snapshot file
+class SnapshotReader {
+private:
+    char* base;
+    unsigned long long length;
+    bool mapped;                    // false: base was read into a heap buffer
+    const SnapshotHeader* header;
+    const SnapshotRecord* records;
+    const char* textArea;
+    std::shared_ptr<const TextSource> shared;  // set once shareText() took over base
+
+public:
+    // Constructor & Destructor
+    SnapshotReader();
+    ~SnapshotReader();
+
+    SnapshotReader(const SnapshotReader&) = delete;
+    SnapshotReader& operator=(const SnapshotReader&) = delete;
+
+    // Map the file; fails if it is missing, malformed or stale
+    bool open(const std::string& path, unsigned long long sourceKey,
+              unsigned long long vocabularyKey);
+    void close();
+    bool isOpen() const;
+
+    int size() const;
+    const SnapshotRecord& record(int index) const;
+
+    // Text of a record (pointer into the mapping plus length)
+    const char* text(int index) const;
+    const char* title(int index) const;
+
+    std::string textString(int index) const;
+    std::string titleString(int index) const;
+
+    // Where a record's text is in the text area
+    TextRef textRef(int index) const;
+
+    // The mapping as a text source for the records. From the first call on
+    // the source owns the mapping, which stays alive after close() for as
+    // long as the source is used.
+    std::shared_ptr<const TextSource> shareText();
+};
+
+#endif
@@ -0,0 +1,69 @@
+#include "StringPool.hpp"
+
+// Constructor
+StringPool::StringPool() : capacity(64), count(0) {
+    slots = new std::string*[capacity];
+    for (int i = 0; i < capacity; i++) slots[i] = nullptr;
+}
+
+// Destructor
+StringPool::~StringPool() {
+    for (int i = 0; i < capacity; i++) delete slots[i];
+    delete[] slots;
+}
+
+// FNV-1a hash
+unsigned int StringPool::hash(const std::string& s) {
+    unsigned int h = 2166136261u;
+    for (size_t i = 0; i < s.size(); i++) {
+        h ^= (unsigned char)s[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+// Double the table and reinsert every stored string
+void StringPool::grow() {
+    int oldCapacity = capacity;
+    std::string** oldSlots = slots;
+    
+    capacity *= 2;
+    slots = new std::string*[capacity];
+    for (int i = 0; i < capacity; i++) slots[i] = nullptr;
+    
+    for (int i = 0; i < oldCapacity; i++) {
+        if (oldSlots[i] == nullptr) continue;
+        unsigned int pos = hash(*oldSlots[i]) & (capacity - 1);
+        while (slots[pos] != nullptr) pos = (pos + 1) & (capacity - 1);
+        slots[pos] = oldSlots[i];
+    }
+    delete[] oldSlots;
+}
+
+// Find or add a string
+const std::string* StringPool::intern(const std::string& s) {
+    std::lock_guard<std::mutex> guard(lock);
+    unsigned int pos = hash(s) & (capacity - 1);
+    while (slots[pos] != nullptr) {
+        if (*slots[pos] == s) return slots[pos];
+        pos = (pos + 1) & (capacity - 1);
+    }
+    
+    slots[pos] = new std::string(s);
+    count++;
+    const std::string* stored = slots[pos];
+    
+    // Keep the load factor under 1/2
+    if (count * 2 > capacity) grow();
+    return stored;
+}
+
+int StringPool::size() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return count;
+}
+
+StringPool& StringPool::shared() {
+    static StringPool pool;
+    return pool;
+}
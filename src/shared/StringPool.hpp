@@ -0,0 +1,40 @@
+#ifndef STRINGPOOL_HPP
+#define STRINGPOOL_HPP
+
+#include <mutex>
+#include <string>
+
+// String interning pool for fields that repeat across many records
+// (skills, company, job title). Each distinct value is stored once and records
+// keep a pointer to it; pointers stay valid for the lifetime of the pool.
+// Nothing is ever removed, so values unique to one record (names, emails)
+// don't belong here: every reload of changed data would add to the pool.
+class StringPool {
+private:
+    std::string** slots;    // open addressing hash table
+    int capacity;           // always a power of two
+    int count;
+    mutable std::mutex lock;    // records may be loaded on a background thread
+    
+    static unsigned int hash(const std::string& s);
+    void grow();
+
+public:
+    // Constructor & Destructor
+    StringPool();
+    ~StringPool();
+    
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+    
+    // Stored copy of s (added on first use)
+    const std::string* intern(const std::string& s);
+    
+    // Number of distinct strings
+    int size() const;
+    
+    // Pool shared by the record classes of both implementations
+    static StringPool& shared();
+};
+
+#endif
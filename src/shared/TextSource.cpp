@@ -0,0 +1,54 @@
+#include "TextSource.hpp"
+#include <cstring>
+#include <utility>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+
+// TextSource
+TextSource::TextSource(char* base, unsigned long long length, bool mapped,
+                       unsigned long long textOffset, unsigned long long textSize)
+    : base(base), length(length), mapped(mapped), text(base + textOffset), textSize(textSize) {}
+
+TextSource::TextSource(const std::string& s)
+    : base(new char[s.size() > 0 ? s.size() : 1]), length(s.size()), mapped(false), text(nullptr),
+      textSize(s.size()) {
+    memcpy(base, s.data(), s.size());
+    text = base;
+}
+
+TextSource::~TextSource() {
+#ifndef _WIN32
+    if (mapped) {
+        munmap(base, length);
+        return;
+    }
+#endif
+    delete[] base;
+}
+
+std::string TextSource::get(TextRef ref) const {
+    if (ref.offset > textSize || ref.length > textSize - ref.offset) return "";
+    return std::string(text + ref.offset, ref.length);
+}
+
+void TextSource::evict() const {
+#ifndef _WIN32
+    if (mapped && length > 0) madvise(base, length, MADV_DONTNEED);
+#endif
+}
+
+// LazyText
+LazyText::LazyText(const std::string& text) {
+    if (text.empty()) return;
+    source = std::make_shared<const TextSource>(text);
+    ref.length = (unsigned int)text.size();
+}
+
+LazyText::LazyText(std::shared_ptr<const TextSource> source, TextRef ref)
+    : source(std::move(source)), ref(ref) {}
+
+std::string LazyText::str() const {
+    return source ? source->get(ref) : std::string();
+}
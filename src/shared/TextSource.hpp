@@ -0,0 +1,68 @@
+#ifndef TEXTSOURCE_HPP
+#define TEXTSOURCE_HPP
+
+#include <memory>
+#include <string>
+
+// Record text kept out of the records. Descriptions and summaries are only
+// read for display, so a record stores where its text is (a TextRef) and
+// the bytes live in one TextSource shared by the whole data set: the text
+// area of a memory-mapped snapshot file, or an in-memory buffer when no
+// snapshot could be written (see SnapshotWriter::writeAndShareText).
+// Mapped text takes no memory until it is read, and evict() gives pages
+// read while loading back to the kernel.
+
+// Position of one text in its source
+struct TextRef {
+    unsigned long long offset = 0;
+    unsigned int length = 0;
+};
+
+class TextSource {
+private:
+    char* base;                     // mapping or heap buffer
+    unsigned long long length;
+    bool mapped;
+    const char* text;               // text area inside base
+    unsigned long long textSize;
+
+public:
+    // Takes ownership of base: unmapped if mapped, delete[]d otherwise
+    TextSource(char* base, unsigned long long length, bool mapped,
+               unsigned long long textOffset, unsigned long long textSize);
+    // Copy of one string (TextRef{0, size})
+    explicit TextSource(const std::string& text);
+    ~TextSource();
+
+    TextSource(const TextSource&) = delete;
+    TextSource& operator=(const TextSource&) = delete;
+
+    // Materialize one text ("" if the reference is out of range)
+    std::string get(TextRef ref) const;
+
+    unsigned long long size() const { return textSize; }
+    bool isMapped() const { return mapped; }
+
+    // Drop mapped pages from memory; they are read back from the file the
+    // next time a text is used. No effect on in-memory sources.
+    void evict() const;
+};
+
+// Text of one record: a reference into a shared source, materialized when
+// read. Text given as a string gets a source of its own.
+class LazyText {
+private:
+    std::shared_ptr<const TextSource> source;
+    TextRef ref;
+
+public:
+    LazyText() {}
+    explicit LazyText(const std::string& text);
+    LazyText(std::shared_ptr<const TextSource> source, TextRef ref);
+
+    std::string str() const;
+    unsigned int size() const { return ref.length; }
+    bool empty() const { return ref.length == 0; }
+};
+
+#endif
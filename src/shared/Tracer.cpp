@@ -0,0 +1,147 @@
+#include "Tracer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+std::atomic<bool> g_traceOn(false);
+
+static const unsigned long long RING_SIZE = 1 << 16;      // events per thread
+
+struct TraceEvent {
+    const char* name;
+    const char* category;
+    const char* argName;
+    long long arg;
+    long long ns;           // since the trace started
+    char phase;             // 'B' or 'E'
+};
+
+// One thread's ring. Only the owning thread writes; head counts every event
+// written and is published after the event itself.
+struct ThreadTrace {
+    int tid;
+    std::atomic<const char*> name;
+    std::atomic<unsigned long long> head;
+    ThreadTrace* next;
+    TraceEvent events[RING_SIZE];
+};
+
+// Registered rings (lock-free push, never removed: a thread's events
+// outlive the thread)
+static std::atomic<ThreadTrace*> g_threads(nullptr);
+static std::atomic<int> g_nextTid(1);
+static std::chrono::steady_clock::time_point g_start;
+static const char* g_path = nullptr;
+static thread_local ThreadTrace* t_trace = nullptr;
+
+static ThreadTrace* threadTrace() {
+    ThreadTrace* t = t_trace;
+    if (t == nullptr) {
+        t = new ThreadTrace;
+        t->tid = g_nextTid.fetch_add(1);
+        t->name.store(nullptr);
+        t->head.store(0);
+        ThreadTrace* first = g_threads.load();
+        do {
+            t->next = first;
+        } while (!g_threads.compare_exchange_weak(first, t));
+        t_trace = t;
+    }
+    return t;
+}
+
+static void record(char phase, const char* name, const char* category, const char* argName, long long arg) {
+    ThreadTrace* t = threadTrace();
+    unsigned long long h = t->head.load(std::memory_order_relaxed);
+    TraceEvent& e = t->events[h & (RING_SIZE - 1)];
+    e.name = name;
+    e.category = category;
+    e.argName = argName;
+    e.arg = arg;
+    e.ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - g_start).count();
+    e.phase = phase;
+    t->head.store(h + 1, std::memory_order_release);
+}
+
+void traceBegin(const char* name, const char* category, const char* argName, long long arg) {
+    if (traceEnabled()) record('B', name, category, argName, arg);
+}
+
+void traceEnd(const char* name, const char* category) {
+    if (traceEnabled()) record('E', name, category, nullptr, 0);
+}
+
+void traceThreadName(const char* name) {
+    if (traceEnabled()) threadTrace()->name.store(name);
+}
+
+static bool byTid(const ThreadTrace* a, const ThreadTrace* b) { return a->tid < b->tid; }
+
+bool traceWrite() {
+    if (!traceEnabled()) return false;
+    FILE* f = std::fopen(g_path, "w");
+    if (f == nullptr) {
+        std::fprintf(stderr, "Could not write trace to %s\n", g_path);
+        return false;
+    }
+
+    std::vector<ThreadTrace*> threads;
+    for (ThreadTrace* t = g_threads.load(); t != nullptr; t = t->next) threads.push_back(t);
+    std::sort(threads.begin(), threads.end(), byTid);
+
+    std::fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    bool first = true;
+    long long written = 0;
+    for (size_t i = 0; i < threads.size(); i++) {
+        const ThreadTrace* t = threads[i];
+        const char* name = t->name.load();
+        std::fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+                        "\"args\":{\"name\":\"%s\"}}",
+                     first ? "" : ",\n", t->tid, name != nullptr ? name : "thread");
+        first = false;
+
+        // A wrapped ring may start inside a scope; drop ends with no begin
+        unsigned long long head = t->head.load(std::memory_order_acquire);
+        unsigned long long from = head > RING_SIZE ? head - RING_SIZE : 0;
+        int depth = 0;
+        for (unsigned long long k = from; k < head; k++) {
+            const TraceEvent& e = t->events[k & (RING_SIZE - 1)];
+            if (e.phase == 'E') {
+                if (depth == 0) continue;
+                depth--;
+            } else {
+                depth++;
+            }
+            std::fprintf(f, ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%d",
+                         e.name, e.category, e.phase, e.ns / 1000.0, t->tid);
+            if (e.argName != nullptr) std::fprintf(f, ",\"args\":{\"%s\":%lld}", e.argName, e.arg);
+            std::fprintf(f, "}");
+            written++;
+        }
+    }
+    std::fprintf(f, "\n]}\n");
+    std::fclose(f);
+    std::fprintf(stderr, "Trace: %lld events from %d threads written to %s\n",
+                 written, (int)threads.size(), g_path);
+    return true;
+}
+
+static void writeAtExit() { traceWrite(); }
+
+// Reads JM_TRACE before main() runs
+struct TraceSetup {
+    TraceSetup() {
+        const char* path = std::getenv("JM_TRACE");
+        if (path == nullptr || *path == '\0') return;
+        g_path = path;
+        g_start = std::chrono::steady_clock::now();
+        g_traceOn.store(true);
+        traceThreadName("main");
+        std::atexit(writeAtExit);
+    }
+};
+
+static TraceSetup g_traceSetup;
@@ -0,0 +1,52 @@
+#ifndef TRACER_HPP
+#define TRACER_HPP
+
+#include <atomic>
+
+// Opt-in timeline tracer producing Chrome trace-event JSON
+// (open in chrome://tracing or https://ui.perfetto.dev).
+//
+// Set JM_TRACE=<file.json> to enable it; the trace is written when the
+// program exits. Each thread records begin/end events into its own ring
+// buffer (single writer, no locks); when a ring fills, its oldest events
+// are overwritten. Forked worker processes don't contribute events.
+//
+// Event names, categories and argument names are stored by pointer, so
+// they must be string literals.
+
+extern std::atomic<bool> g_traceOn;
+
+inline bool traceEnabled() { return g_traceOn.load(std::memory_order_relaxed); }
+
+void traceBegin(const char* name, const char* category, const char* argName = nullptr, long long arg = 0);
+void traceEnd(const char* name, const char* category);
+
+// Label the calling thread in the viewer
+void traceThreadName(const char* name);
+
+// Write the trace now (also done automatically at exit); false on error
+bool traceWrite();
+
+// Begin/end pair for a scope
+class TraceScope {
+private:
+    const char* name;
+    const char* category;
+
+public:
+    TraceScope(const char* name, const char* category, const char* argName = nullptr, long long arg = 0)
+        : name(nullptr), category(category) {
+        if (traceEnabled()) {
+            this->name = name;
+            traceBegin(name, category, argName, arg);
+        }
+    }
+    ~TraceScope() {
+        if (name != nullptr) traceEnd(name, category);
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+};
+
+#endif
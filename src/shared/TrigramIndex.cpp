@@ -0,0 +1,226 @@
+#include "TrigramIndex.hpp"
+#include <algorithm>
+#include <utility>
+
+// Alphabet position of a normalized character (space, a-z, 0-9)
+static inline int trigramChar(char c) {
+    if (c == ' ') return 0;
+    if (c >= 'a' && c <= 'z') return 1 + (c - 'a');
+    return 27 + (c - '0');
+}
+
+// First element of [p, end) that is >= target (p only moves forward)
+static const int* gallop(const int* p, const int* end, int target) {
+    if (p == end || *p >= target) return p;
+    int step = 1;
+    const int* lo = p;
+    while (end - lo > step && lo[step] < target) {
+        lo += step;
+        step *= 2;
+    }
+    const int* hi = (end - lo > step) ? lo + step + 1 : end;
+    return std::lower_bound(lo, hi, target);
+}
+
+// TrigramIndex
+TrigramIndex::TrigramIndex() : textStart(1, 0), lists(TRIGRAMS), finished(false) {}
+
+std::string TrigramIndex::normalize(const std::string& s) {
+    std::string out;
+    out.reserve(s.size());
+    bool space = false;
+    for (size_t i = 0; i < s.size(); i++) {
+        char c = s[i];
+        if (c >= 'A' && c <= 'Z') c = (char)(c + 32);
+        if ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9')) {
+            if (space && !out.empty()) out.push_back(' ');
+            out.push_back(c);
+            space = false;
+        } else {
+            space = true;
+        }
+    }
+    return out;
+}
+
+// Distinct trigrams of every word, sorted; padEnd adds the trailing space
+void TrigramIndex::trigramsOf(const std::string& normalized, bool padEnd, std::vector<int>& out) {
+    out.clear();
+    size_t i = 0;
+    while (i < normalized.size()) {
+        size_t end = normalized.find(' ', i);
+        if (end == std::string::npos) end = normalized.size();
+
+        std::string padded = "  " + normalized.substr(i, end - i);
+        if (padEnd) padded.push_back(' ');
+        for (size_t p = 0; p + 3 <= padded.size(); p++) {
+            out.push_back((trigramChar(padded[p]) * 37 + trigramChar(padded[p + 1])) * 37 +
+                          trigramChar(padded[p + 2]));
+        }
+        i = end + 1;
+    }
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+void TrigramIndex::add(int id, const std::string& value) {
+    std::string key = normalize(value);
+    std::unordered_map<std::string, int>::iterator found = entryOf.find(key);
+    int entry;
+    if (found != entryOf.end()) {
+        entry = found->second;
+    } else {
+        entry = (int)entryTrigrams.size();
+        std::vector<int> grams;
+        trigramsOf(key, true, grams);
+        for (size_t g = 0; g < grams.size(); g++) lists[grams[g]].push_back(entry);
+        entryTrigrams.push_back((int)grams.size());
+        text += key;
+        textStart.push_back((int)text.size());
+        entryOf.emplace(std::move(key), entry);
+    }
+    recordEntry.push_back(entry);
+    addedIds.push_back(id);
+}
+
+void TrigramIndex::finish() {
+    if (finished) return;
+    finished = true;
+
+    // Records grouped by entry, keeping the order they were added
+    int entries = (int)entryTrigrams.size();
+    recordStart.assign(entries + 1, 0);
+    for (size_t r = 0; r < recordEntry.size(); r++) recordStart[recordEntry[r] + 1]++;
+    for (int e = 0; e < entries; e++) recordStart[e + 1] += recordStart[e];
+    recordIds.resize(addedIds.size());
+    std::vector<int> next(recordStart.begin(), recordStart.end() - 1);
+    for (size_t r = 0; r < recordEntry.size(); r++) recordIds[next[recordEntry[r]]++] = addedIds[r];
+
+    listStart.assign(TRIGRAMS + 1, 0);
+    for (int t = 0; t < TRIGRAMS; t++) listStart[t + 1] = listStart[t] + (int)lists[t].size();
+    postings.resize(listStart[TRIGRAMS]);
+    for (int t = 0; t < TRIGRAMS; t++) {
+        std::copy(lists[t].begin(), lists[t].end(), postings.begin() + listStart[t]);
+    }
+
+    std::unordered_map<std::string, int>().swap(entryOf);
+    std::vector<std::vector<int> >().swap(lists);
+    std::vector<int>().swap(recordEntry);
+    std::vector<int>().swap(addedIds);
+    text.shrink_to_fit();
+}
+
+int TrigramIndex::entryCount() const { return (int)entryTrigrams.size(); }
+int TrigramIndex::recordCount() const { return (int)recordIds.size(); }
+
+std::string TrigramIndex::entryText(int entry) const {
+    return text.substr(textStart[entry], textStart[entry + 1] - textStart[entry]);
+}
+
+int TrigramIndex::entryRecordCount(int entry) const {
+    return recordStart[entry + 1] - recordStart[entry];
+}
+
+const int* TrigramIndex::entryRecords(int entry) const {
+    return recordIds.data() + recordStart[entry];
+}
+
+long long TrigramIndex::sizeInBytes() const {
+    return (long long)text.capacity() +
+           (long long)sizeof(int) * (textStart.capacity() + entryTrigrams.capacity() +
+                                     recordStart.capacity() + recordIds.capacity() +
+                                     listStart.capacity() + postings.capacity());
+}
+
+// Ranking: whole-query matches, then similarity; ties keep the earlier entry
+static bool ranksAbove(const TrigramIndex::Hit& a, const TrigramIndex::Hit& b) {
+    if (a.containsQuery != b.containsQuery) return a.containsQuery;
+    return a.similarity > b.similarity;
+}
+
+int TrigramIndex::search(const std::string& query, int k, Hit* out, int& verified) const {
+    verified = 0;
+    if (!finished || k <= 0) return 0;
+
+    std::string q = normalize(query);
+    std::vector<int> grams;
+    trigramsOf(q, false, grams);
+    int n = (int)grams.size();
+    if (n == 0) return 0;
+
+    std::sort(grams.begin(), grams.end(), [this](int a, int b) {
+        return listStart[a + 1] - listStart[a] < listStart[b + 1] - listStart[b];
+    });
+
+    // A trigram every entry has ("candidate" in generated names) says nothing
+    // about which entries match: it counts as shared but is never read
+    int entries = entryCount();
+    int m = n;
+    while (m > 0 && listStart[grams[m - 1] + 1] - listStart[grams[m - 1]] == entries) m--;
+    int universal = n - m;
+    int need = std::max((2 * m + 2) / 3, m - 3);
+    int scanned = m > 0 ? m - need + 1 : 0;
+
+    // Candidates: merge the shortest lists, counting the lists each entry is on
+    std::vector<std::pair<int, int> > candidates, merged;      // (entry, lists)
+    if (m == 0) {
+        candidates.reserve(entries);
+        for (int e = 0; e < entries; e++) candidates.push_back(std::make_pair(e, 0));
+    }
+    for (int g = 0; g < scanned; g++) {
+        const int* p = postings.data() + listStart[grams[g]];
+        const int* end = postings.data() + listStart[grams[g] + 1];
+        merged.clear();
+        merged.reserve(candidates.size() + (end - p));
+        size_t c = 0;
+        while (c < candidates.size() || p < end) {
+            if (p == end || (c < candidates.size() && candidates[c].first < *p)) {
+                merged.push_back(candidates[c++]);
+            } else if (c == candidates.size() || *p < candidates[c].first) {
+                merged.push_back(std::make_pair(*p++, 1));
+            } else {
+                merged.push_back(std::make_pair(*p++, candidates[c++].second + 1));
+            }
+        }
+        candidates.swap(merged);
+    }
+
+    // Filter: probe the longer lists (candidates ascend, so cursors only move
+    // forward) until too many trigrams are missing
+    std::vector<const int*> cursor(m);
+    for (int g = scanned; g < m; g++) cursor[g] = postings.data() + listStart[grams[g]];
+
+    int size = 0;
+    for (size_t c = 0; c < candidates.size(); c++) {
+        int entry = candidates[c].first;
+        int shared = candidates[c].second;
+        int missing = scanned - shared;
+        for (int g = scanned; g < m && missing <= m - need; g++) {
+            const int* end = postings.data() + listStart[grams[g] + 1];
+            cursor[g] = gallop(cursor[g], end, entry);
+            if (cursor[g] < end && *cursor[g] == entry) shared++;
+            else missing++;
+        }
+        if (missing > m - need) continue;
+        shared += universal;
+
+        // Verify against the entry's text
+        verified++;
+        const char* first = text.data() + textStart[entry];
+        const char* last = text.data() + textStart[entry + 1];
+        Hit h;
+        h.entry = entry;
+        h.shared = shared;
+        h.similarity = (double)shared / (n + entryTrigrams[entry] - shared);
+        h.containsQuery = std::search(first, last, q.begin(), q.end()) != last;
+
+        if (size == k && !ranksAbove(h, out[size - 1])) continue;
+        int i = size < k ? size++ : size - 1;
+        while (i > 0 && ranksAbove(h, out[i - 1])) {
+            out[i] = out[i - 1];
+            i--;
+        }
+        out[i] = h;
+    }
+    return size;
+}
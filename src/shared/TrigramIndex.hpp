@@ -0,0 +1,82 @@
+#ifndef TRIGRAMINDEX_HPP
+#define TRIGRAMINDEX_HPP
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Approximate lookup over a short text field of every record (job titles,
+// candidate names), for queries like "data sci" -> "Data Scientist".
+//
+// Text is normalized (lowercase; every run of characters other than ASCII
+// letters and digits becomes one space) and each distinct normalized value
+// is one entry holding the ids of its records. Every word of an entry
+// contributes its trigrams padded as "  word ", and every trigram keeps the
+// sorted list of entries containing it. Query words are padded in front
+// only ("  sci"), so a word that is still being typed matches as a prefix.
+//
+// A query accepts entries sharing at least max(ceil(2m / 3), m - 3) of its m
+// distinct trigrams (one typo changes at most three); trigrams that every
+// entry has are counted as shared but left out of m. Search runs in three
+// steps:
+//   candidates - an entry sharing T of m trigrams appears on at least one
+//                of the m - T + 1 shortest lists, so only those are merged
+//   filter     - each candidate is probed in the remaining lists (galloping,
+//                shortest first) until it is known to reach T or not
+//   verify     - survivors are checked against their text: entries that
+//                contain the whole query rank first, then by trigram
+//                similarity, so shorter, closer values win
+class TrigramIndex {
+public:
+    static const int TRIGRAMS = 37 * 37 * 37;  // space, a-z, 0-9
+
+private:
+    // Finished index (compressed sparse rows)
+    std::string text;                   // normalized entries, back to back
+    std::vector<int> textStart;         // entry -> start in text (entries + 1)
+    std::vector<int> entryTrigrams;     // distinct trigrams of each entry
+    std::vector<int> recordStart;       // entry -> start in recordIds (entries + 1)
+    std::vector<int> recordIds;
+    std::vector<int> listStart;         // trigram -> start in postings (TRIGRAMS + 1)
+    std::vector<int> postings;          // entries, ascending within a trigram
+
+    // Building state (released by finish)
+    std::unordered_map<std::string, int> entryOf;
+    std::vector<std::vector<int> > lists;
+    std::vector<int> recordEntry;       // entry of each added record
+    std::vector<int> addedIds;
+    bool finished;
+
+    static std::string normalize(const std::string& s);
+    static void trigramsOf(const std::string& normalized, bool padEnd, std::vector<int>& out);
+
+public:
+    TrigramIndex();
+
+    // Building: add every record's text, then call finish()
+    void add(int id, const std::string& value);
+    void finish();
+
+    int entryCount() const;
+    int recordCount() const;
+    std::string entryText(int entry) const;         // normalized
+    int entryRecordCount(int entry) const;
+    const int* entryRecords(int entry) const;       // ids in the order added
+
+    struct Hit {
+        int entry;
+        int shared;             // query trigrams found in the entry
+        double similarity;      // shared / trigrams of query and entry together
+        bool containsQuery;     // normalized query is a substring of the entry
+    };
+
+    // Up to k best entries for query, best first; returns how many were
+    // written. verified receives the number of candidates that reached the
+    // verify step.
+    int search(const std::string& query, int k, Hit* out, int& verified) const;
+
+    // Memory held by the finished index
+    long long sizeInBytes() const;
+};
+
+#endif
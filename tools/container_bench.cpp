@@ -0,0 +1,557 @@
+// Microbenchmarks for the container primitives of both data structures.
+//
+// Build (one line):
+//   g++ -std=c++17 -O2 tools/container_bench.cpp src/linkedlist_team/JobLinkedList.cpp
+//       src/linkedlist_team/ResumeLinkedList.cpp src/shared/Job.cpp src/shared/Resume.cpp
+//       src/shared/StringPool.cpp src/shared/TextSource.cpp -o container_bench
+//
+// Usage:  container_bench [--sizes 100,1000,...] [--reps N] [--max-quadratic N]
+//                         [--format csv|json] [--out FILE] [--seed N]
+//
+// Containers: JobLinkedList and ResumeLinkedList, and JobArray/ResumeArray,
+// contiguous arrays of the same records using the array engine's algorithms
+// (linear search, exchange sort, shifting inserts and removes).
+//
+// For every size, each repetition builds a fresh container from records with
+// shuffled ids (timed as "insert"), then times each operation over a batch
+// of calls with random arguments and undoes any changes untimed. The batch
+// size is calibrated once per operation so a batch takes at least ~200 us
+// (and makes at least 8 calls where the container allows).
+// Sorts are quadratic here and only run up to --max-quadratic records.
+//
+// Results (ns per call: min, median, mean, stddev, max over repetitions) go
+// to stdout or --out as CSV or JSON. A summary of the growth exponent of each
+// series (slope of log time against log size) goes to stderr, to check the
+// complexity claims the programs print.
+
+#include "../src/linkedlist_team/JobLinkedList.hpp"
+#include "../src/linkedlist_team/ResumeLinkedList.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+typedef std::chrono::steady_clock Clock;
+
+// Barriers: keep the compiler from dropping a result or moving work across
+// the timer reads
+#if defined(__GNUC__) || defined(__clang__)
+template <typename T>
+inline void doNotOptimize(const T& value) { asm volatile("" : : "r,m"(value) : "memory"); }
+inline void clobberMemory() { asm volatile("" : : : "memory"); }
+#else
+static volatile const void* g_sink;
+template <typename T>
+inline void doNotOptimize(const T& value) { g_sink = &value; }
+inline void clobberMemory() {}
+#endif
+
+// Record kinds
+
+struct JobKind {
+    typedef Job Record;
+    typedef JobLinkedList List;
+    static const char* listName() { return "JobLinkedList"; }
+    static const char* arrayName() { return "JobArray"; }
+    static const char* searchTextOp() { return "searchByTitle"; }
+    static const char* getAtOp() { return "getJobAt"; }
+
+    static std::string text(int id) { return "Title " + std::to_string(id); }
+    static Record make(int id, int years) { return Job(id, text(id), "Tech Company", "", years); }
+    static bool hasText(const Record& r, const std::string& s) { return r.getTitle() == s; }
+    static int years(const Record& r) { return r.getExperienceRequired(); }
+
+    static Record* listSearchText(List& l, const std::string& s) { return l.searchByTitle(s); }
+    static Record* listGetAt(List& l, int i) { return l.getJobAt(i); }
+};
+
+struct ResumeKind {
+    typedef Resume Record;
+    typedef ResumeLinkedList List;
+    static const char* listName() { return "ResumeLinkedList"; }
+    static const char* arrayName() { return "ResumeArray"; }
+    static const char* searchTextOp() { return "searchByName"; }
+    static const char* getAtOp() { return "getResumeAt"; }
+
+    static std::string text(int id) { return Resume::candidateName(id); }
+    static Record make(int id, int years) { return Resume(id, "", years); }
+    static bool hasText(const Record& r, const std::string& s) { return r.hasName(s); }
+    static int years(const Record& r) { return r.getYearsOfExperience(); }
+
+    static Record* listSearchText(List& l, const std::string& s) { return l.searchByName(s); }
+    static Record* listGetAt(List& l, int i) { return l.getResumeAt(i); }
+};
+
+// Containers, behind one interface
+
+template <typename Kind>
+class ListContainer {
+public:
+    typedef typename Kind::Record Record;
+    static const char* name() { return Kind::listName(); }
+
+    void insert(Record&& r) { list.insert(std::move(r)); }
+    void insertAtBeginning(Record&& r) { list.insertAtBeginning(std::move(r)); }
+    void insertAtPosition(const Record& r, int position) { list.insertAtPosition(r, position); }
+    bool remove(int id) { return list.remove(id); }
+    Record* search(int id) { return list.search(id); }
+    Record* searchText(const std::string& s) { return Kind::listSearchText(list, s); }
+    Record* getAt(int i) { return Kind::listGetAt(list, i); }
+    void sortById() { list.sortById(); }
+    void sortByExperience() { list.sortByExperience(); }
+    int size() const { return list.getSize(); }
+
+private:
+    typename Kind::List list;
+};
+
+// Growable array with the array engine's algorithms
+template <typename Kind>
+class ArrayContainer {
+public:
+    typedef typename Kind::Record Record;
+    static const char* name() { return Kind::arrayName(); }
+
+    ArrayContainer() : items(nullptr), count(0), capacity(0) {}
+    ~ArrayContainer() { delete[] items; }
+    ArrayContainer(const ArrayContainer&) = delete;
+    ArrayContainer& operator=(const ArrayContainer&) = delete;
+
+    void insert(Record&& r) {
+        reserveOne();
+        items[count++] = std::move(r);
+    }
+    void insertAtBeginning(Record&& r) { insertAtPosition(std::move(r), 0); }
+    void insertAtPosition(Record r, int position) {
+        if (position < 0 || position > count) return;
+        reserveOne();
+        for (int i = count; i > position; i--) items[i] = std::move(items[i - 1]);
+        items[position] = std::move(r);
+        count++;
+    }
+    bool remove(int id) {
+        for (int i = 0; i < count; i++) {
+            if (items[i].getId() != id) continue;
+            for (int k = i; k < count - 1; k++) items[k] = std::move(items[k + 1]);
+            count--;
+            return true;
+        }
+        return false;
+    }
+    Record* search(int id) {
+        for (int i = 0; i < count; i++) {
+            if (items[i].getId() == id) return &items[i];
+        }
+        return nullptr;
+    }
+    Record* searchText(const std::string& s) {
+        for (int i = 0; i < count; i++) {
+            if (Kind::hasText(items[i], s)) return &items[i];
+        }
+        return nullptr;
+    }
+    Record* getAt(int i) { return (i >= 0 && i < count) ? &items[i] : nullptr; }
+    void sortById() {
+        for (int i = 0; i < count - 1; i++)
+            for (int k = i + 1; k < count; k++)
+                if (items[k].getId() < items[i].getId()) std::swap(items[i], items[k]);
+    }
+    void sortByExperience() {
+        for (int i = 0; i < count - 1; i++)
+            for (int k = i + 1; k < count; k++)
+                if (Kind::years(items[k]) < Kind::years(items[i])) std::swap(items[i], items[k]);
+    }
+    int size() const { return count; }
+
+private:
+    Record* items;
+    int count;
+    int capacity;
+
+    void reserveOne() {
+        if (count < capacity) return;
+        int grown = capacity > 0 ? capacity * 2 : 16;
+        Record* bigger = new Record[grown];
+        for (int i = 0; i < count; i++) bigger[i] = std::move(items[i]);
+        delete[] items;
+        items = bigger;
+        capacity = grown;
+    }
+};
+
+// Driver
+
+enum Op {
+    OP_INSERT, OP_INSERT_BEGINNING, OP_INSERT_POSITION, OP_REMOVE, OP_SEARCH,
+    OP_SEARCH_TEXT, OP_GET_AT, OP_SORT_ID, OP_SORT_EXPERIENCE, OP_COUNT
+};
+
+struct Options {
+    std::vector<int> sizes;
+    int reps = 5;
+    int maxQuadratic = 10000;
+    bool json = false;
+    std::string out;
+    unsigned seed = 42;
+};
+
+struct Result {
+    std::string container;
+    std::string operation;
+    int size;
+    int reps;
+    long long calls;
+    double minNs, medianNs, meanNs, stddevNs, maxNs;
+};
+
+template <typename Kind>
+static const char* opName(int op) {
+    switch (op) {
+        case OP_INSERT:          return "insert";
+        case OP_INSERT_BEGINNING: return "insertAtBeginning";
+        case OP_INSERT_POSITION: return "insertAtPosition";
+        case OP_REMOVE:          return "remove";
+        case OP_SEARCH:          return "search";
+        case OP_SEARCH_TEXT:     return Kind::searchTextOp();
+        case OP_GET_AT:          return Kind::getAtOp();
+        case OP_SORT_ID:         return "sortById";
+        case OP_SORT_EXPERIENCE: return "sortByExperience";
+        default:                 return "unknown";
+    }
+}
+
+static long long elapsedNs(Clock::time_point t0) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count();
+}
+
+// Most calls a batch of op may make on n records (removes take distinct ids)
+static long long maxCalls(int op, int n) {
+    if (op == OP_REMOVE) return std::max(1, n / 4);
+    return 4096;
+}
+
+// One timed batch of `calls` calls of op on c (n records, ids 1..n).
+// Arguments are drawn before the clock starts; changes are undone after it stops.
+template <typename Kind, typename Container>
+static long long timeBatch(Container& c, int op, int n, long long calls, std::mt19937& rng) {
+    typedef typename Kind::Record Record;
+    std::uniform_int_distribution<int> anyId(1, n);
+    std::uniform_int_distribution<int> anyIndex(0, n - 1);
+    std::vector<int> args((size_t)calls);
+    std::vector<Record> records;
+    long long ns = 0;
+
+    switch (op) {
+        case OP_INSERT_BEGINNING:
+        case OP_INSERT_POSITION: {
+            for (long long i = 0; i < calls; i++) {
+                records.push_back(Kind::make(n + 1 + (int)i, (int)(rng() % 16)));
+                args[i] = anyIndex(rng);
+            }
+            Clock::time_point t0 = Clock::now();
+            for (long long i = 0; i < calls; i++) {
+                if (op == OP_INSERT_BEGINNING) c.insertAtBeginning(std::move(records[i]));
+                else c.insertAtPosition(records[i], args[i]);
+            }
+            clobberMemory();
+            ns = elapsedNs(t0);
+            for (long long i = 0; i < calls; i++) c.remove(n + 1 + (int)i);
+            break;
+        }
+        case OP_REMOVE: {
+            // Distinct ids, so every call finds its record
+            std::vector<int> ids(n);
+            for (int i = 0; i < n; i++) ids[i] = i + 1;
+            std::shuffle(ids.begin(), ids.end(), rng);
+            for (long long i = 0; i < calls; i++) args[i] = ids[i];
+            for (long long i = 0; i < calls; i++) records.push_back(*c.search(args[i]));
+            Clock::time_point t0 = Clock::now();
+            for (long long i = 0; i < calls; i++) {
+                bool ok = c.remove(args[i]);
+                doNotOptimize(ok);
+            }
+            clobberMemory();
+            ns = elapsedNs(t0);
+            for (long long i = 0; i < calls; i++) c.insert(std::move(records[i]));
+            break;
+        }
+        case OP_SEARCH:
+        case OP_GET_AT: {
+            for (long long i = 0; i < calls; i++) args[i] = (op == OP_SEARCH) ? anyId(rng) : anyIndex(rng);
+            Clock::time_point t0 = Clock::now();
+            for (long long i = 0; i < calls; i++) {
+                Record* r = (op == OP_SEARCH) ? c.search(args[i]) : c.getAt(args[i]);
+                doNotOptimize(r);
+            }
+            clobberMemory();
+            ns = elapsedNs(t0);
+            break;
+        }
+        case OP_SEARCH_TEXT: {
+            std::vector<std::string> keys;
+            for (long long i = 0; i < calls; i++) keys.push_back(Kind::text(anyId(rng)));
+            Clock::time_point t0 = Clock::now();
+            for (long long i = 0; i < calls; i++) {
+                Record* r = c.searchText(keys[i]);
+                doNotOptimize(r);
+            }
+            clobberMemory();
+            ns = elapsedNs(t0);
+            break;
+        }
+    }
+    return ns;
+}
+
+static void summarize(std::vector<double>& samples, Result& r) {
+    std::sort(samples.begin(), samples.end());
+    size_t k = samples.size();
+    double sum = 0;
+    for (size_t i = 0; i < k; i++) sum += samples[i];
+    r.minNs = samples.front();
+    r.maxNs = samples.back();
+    r.medianNs = (k % 2 == 1) ? samples[k / 2] : (samples[k / 2 - 1] + samples[k / 2]) / 2;
+    r.meanNs = sum / k;
+    double var = 0;
+    for (size_t i = 0; i < k; i++) var += (samples[i] - r.meanNs) * (samples[i] - r.meanNs);
+    r.stddevNs = k > 1 ? std::sqrt(var / (k - 1)) : 0.0;
+}
+
+template <typename Kind, typename Container>
+static void benchContainer(const Options& opt, std::vector<Result>& results) {
+    typedef typename Kind::Record Record;
+
+    for (size_t s = 0; s < opt.sizes.size(); s++) {
+        int n = opt.sizes[s];
+        bool quadratic = n <= opt.maxQuadratic;
+        std::vector<double> samples[OP_COUNT];
+        long long calls[OP_COUNT];
+        for (int op = 0; op < OP_COUNT; op++) calls[op] = 0;
+
+        std::cerr << Container::name() << " n=" << n << "...\n";
+        for (int rep = 0; rep < opt.reps; rep++) {
+            std::mt19937 rng(opt.seed + 7919u * (unsigned)rep + (unsigned)n);
+
+            // Shuffled ids and random experience, prepared untimed
+            std::vector<int> ids(n), years(n);
+            for (int i = 0; i < n; i++) ids[i] = i + 1;
+            std::shuffle(ids.begin(), ids.end(), rng);
+            for (int i = 0; i < n; i++) years[i] = (int)(rng() % 16);
+            std::vector<Record> records;
+            records.reserve(n);
+            for (int i = 0; i < n; i++) records.push_back(Kind::make(ids[i], years[i]));
+
+            Container* c = new Container;
+            Clock::time_point t0 = Clock::now();
+            for (int i = 0; i < n; i++) c->insert(std::move(records[i]));
+            clobberMemory();
+            samples[OP_INSERT].push_back((double)elapsedNs(t0) / n);
+            calls[OP_INSERT] = n;
+
+            for (int op = OP_INSERT_BEGINNING; op <= OP_GET_AT; op++) {
+                if (calls[op] == 0) {
+                    // Calibrate the batch size on the first repetition
+                    long long most = maxCalls(op, n);
+                    long long k = std::min(8LL, most);
+                    while (timeBatch<Kind>(*c, op, n, k, rng) < 200000 && k * 2 <= most) k *= 2;
+                    calls[op] = k;
+                }
+                samples[op].push_back((double)timeBatch<Kind>(*c, op, n, calls[op], rng) / calls[op]);
+            }
+            delete c;
+
+            if (quadratic) {
+                // Sorts get a fresh container in the shuffled order
+                Container* fresh = new Container;
+                for (int i = 0; i < n; i++) fresh->insert(Kind::make(ids[i], years[i]));
+
+                Clock::time_point t1 = Clock::now();
+                fresh->sortById();
+                clobberMemory();
+                samples[OP_SORT_ID].push_back((double)elapsedNs(t1));
+                calls[OP_SORT_ID] = 1;
+
+                Clock::time_point t2 = Clock::now();
+                fresh->sortByExperience();
+                clobberMemory();
+                samples[OP_SORT_EXPERIENCE].push_back((double)elapsedNs(t2));
+                calls[OP_SORT_EXPERIENCE] = 1;
+                delete fresh;
+            }
+        }
+
+        for (int op = 0; op < OP_COUNT; op++) {
+            if (samples[op].empty()) continue;
+            Result r;
+            r.container = Container::name();
+            r.operation = opName<Kind>(op);
+            r.size = n;
+            r.reps = (int)samples[op].size();
+            r.calls = calls[op];
+            summarize(samples[op], r);
+            results.push_back(r);
+        }
+    }
+}
+
+// Least-squares slope of log(median) against log(size) for one series
+static double growthExponent(const std::vector<Result>& results, const std::string& container,
+                             const std::string& op, int& points) {
+    double sx = 0, sy = 0, sxx = 0, sxy = 0;
+    points = 0;
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result& r = results[i];
+        if (r.container != container || r.operation != op || r.medianNs <= 0) continue;
+        double x = std::log((double)r.size), y = std::log(r.medianNs);
+        sx += x; sy += y; sxx += x * x; sxy += x * y;
+        points++;
+    }
+    if (points < 2) return 0;
+    double d = points * sxx - sx * sx;
+    return d != 0 ? (points * sxy - sx * sy) / d : 0;
+}
+
+static const char* growthClass(double exponent) {
+    if (exponent < 0.25) return "O(1)";
+    if (exponent < 0.75) return "sublinear";
+    if (exponent < 1.3)  return "O(n)";
+    if (exponent < 1.75) return "superlinear";
+    return "O(n^2)";
+}
+
+static void writeCsv(std::ostream& out, const std::vector<Result>& results) {
+    out << "container,operation,size,repetitions,calls,min_ns,median_ns,mean_ns,stddev_ns,max_ns\n";
+    char line[512];
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result& r = results[i];
+        snprintf(line, sizeof(line), "%s,%s,%d,%d,%lld,%.1f,%.1f,%.1f,%.1f,%.1f\n",
+                 r.container.c_str(), r.operation.c_str(), r.size, r.reps, r.calls,
+                 r.minNs, r.medianNs, r.meanNs, r.stddevNs, r.maxNs);
+        out << line;
+    }
+}
+
+static void writeJson(std::ostream& out, const Options& opt, const std::vector<Result>& results,
+                      const std::vector<std::pair<std::string, std::string> >& series) {
+    char line[512];
+    out << "{\n  \"repetitions\": " << opt.reps << ",\n  \"maxQuadratic\": " << opt.maxQuadratic
+        << ",\n  \"seed\": " << opt.seed << ",\n  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result& r = results[i];
+        snprintf(line, sizeof(line),
+                 "    {\"container\": \"%s\", \"operation\": \"%s\", \"size\": %d, \"repetitions\": %d, "
+                 "\"calls\": %lld, \"min_ns\": %.1f, \"median_ns\": %.1f, \"mean_ns\": %.1f, "
+                 "\"stddev_ns\": %.1f, \"max_ns\": %.1f}%s\n",
+                 r.container.c_str(), r.operation.c_str(), r.size, r.reps, r.calls,
+                 r.minNs, r.medianNs, r.meanNs, r.stddevNs, r.maxNs, i + 1 < results.size() ? "," : "");
+        out << line;
+    }
+    out << "  ],\n  \"growth\": [\n";
+    for (size_t i = 0; i < series.size(); i++) {
+        int points;
+        double e = growthExponent(results, series[i].first, series[i].second, points);
+        snprintf(line, sizeof(line),
+                 "    {\"container\": \"%s\", \"operation\": \"%s\", \"sizes\": %d, \"exponent\": %.2f, "
+                 "\"class\": \"%s\"}%s\n",
+                 series[i].first.c_str(), series[i].second.c_str(), points, e,
+                 points >= 2 ? growthClass(e) : "n/a", i + 1 < series.size() ? "," : "");
+        out << line;
+    }
+    out << "  ]\n}\n";
+}
+
+static bool parseSizes(const char* text, std::vector<int>& sizes) {
+    sizes.clear();
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        int n = atoi(item.c_str());
+        if (n < 1) return false;
+        sizes.push_back(n);
+    }
+    return !sizes.empty();
+}
+
+static int usage() {
+    std::cerr << "usage: container_bench [--sizes 100,1000,...] [--reps N] [--max-quadratic N]\n"
+              << "                       [--format csv|json] [--out FILE] [--seed N]\n";
+    return 2;
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    opt.sizes = {100, 1000, 10000, 100000, 1000000};
+
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (a == "--sizes" && hasValue) {
+            if (!parseSizes(argv[++i], opt.sizes)) return usage();
+        } else if (a == "--reps" && hasValue) {
+            opt.reps = atoi(argv[++i]);
+            if (opt.reps < 1) return usage();
+        } else if (a == "--max-quadratic" && hasValue) {
+            opt.maxQuadratic = atoi(argv[++i]);
+        } else if (a == "--format" && hasValue) {
+            std::string f = argv[++i];
+            if (f != "csv" && f != "json") return usage();
+            opt.json = (f == "json");
+        } else if (a == "--out" && hasValue) {
+            opt.out = argv[++i];
+        } else if (a == "--seed" && hasValue) {
+            opt.seed = (unsigned)strtoul(argv[++i], nullptr, 10);
+        } else {
+            return usage();
+        }
+    }
+
+    std::vector<Result> results;
+    benchContainer<JobKind, ListContainer<JobKind> >(opt, results);
+    benchContainer<JobKind, ArrayContainer<JobKind> >(opt, results);
+    benchContainer<ResumeKind, ListContainer<ResumeKind> >(opt, results);
+    benchContainer<ResumeKind, ArrayContainer<ResumeKind> >(opt, results);
+
+    // Series in first-seen order
+    std::vector<std::pair<std::string, std::string> > series;
+    for (size_t i = 0; i < results.size(); i++) {
+        std::pair<std::string, std::string> key(results[i].container, results[i].operation);
+        if (std::find(series.begin(), series.end(), key) == series.end()) series.push_back(key);
+    }
+
+    std::ofstream file;
+    if (!opt.out.empty()) {
+        file.open(opt.out.c_str());
+        if (!file.is_open()) {
+            std::cerr << "Could not write " << opt.out << "\n";
+            return 1;
+        }
+    }
+    std::ostream& out = opt.out.empty() ? std::cout : file;
+    if (opt.json) writeJson(out, opt, results, series);
+    else writeCsv(out, results);
+
+    std::cerr << "\nGrowth (ns per call vs size, log-log slope of the median)\n";
+    for (size_t i = 0; i < series.size(); i++) {
+        int points;
+        double e = growthExponent(results, series[i].first, series[i].second, points);
+        char line[160];
+        if (points >= 2) {
+            snprintf(line, sizeof(line), "  %-18s %-18s %5.2f  %s\n", series[i].first.c_str(),
+                     series[i].second.c_str(), e, growthClass(e));
+        } else {
+            snprintf(line, sizeof(line), "  %-18s %-18s  n/a  (one size)\n", series[i].first.c_str(),
+                     series[i].second.c_str());
+        }
+        std::cerr << line;
+    }
+    return 0;
+}
@@ -0,0 +1,229 @@
+// Client for the array engine's query server (Array menu, option 15).
+//
+// Build:  g++ -std=c++17 -O2 tools/query_client.cpp -o query_client -lpthread
+//
+// Usage:  query_client <socket> job <jobId> [k]          best resumes for a job
+//         query_client <socket> resume <resumeId> [k]    best jobs for a resume
+//         query_client <socket> bench <connections> <requests> [k] [maxJobId]
+//         query_client <socket> shutdown
+//
+// bench opens <connections> connections, each sending <requests> candidate
+// queries for random job ids in 1..maxJobId (default 10000), one at a time,
+// and reports client-side latency percentiles and throughput.
+
+#include "../src/array_team/QueryProtocol.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+using namespace arr;
+typedef std::chrono::steady_clock Clock;
+
+static int connectTo(const char* path) {
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(address.sun_path)) return -1;
+    strcpy(address.sun_path, path);
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    if (::connect(fd, (sockaddr*)&address, sizeof(address)) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Send one request and wait for its response
+static bool roundTrip(int fd, const QueryRequest& request, int& status, QueryRow* rows, int& count) {
+    char frame[QUERY_MAX_FRAME + 4];
+    int length = encodeRequest(request, frame);
+    if (!querySendAll(fd, frame, length)) return false;
+
+    unsigned int bodyLength, requestId;
+    if (!queryReadFrame(fd, frame, bodyLength)) return false;
+    if (!decodeResponse(frame, bodyLength, requestId, status, rows, count)) return false;
+    return requestId == request.requestId;
+}
+
+static const char* statusName(int status) {
+    switch (status) {
+        case QUERY_OK:          return "OK";
+        case QUERY_NOT_FOUND:   return "not found";
+        case QUERY_BAD_REQUEST: return "bad request";
+        default:                return "unknown status";
+    }
+}
+
+static int runQuery(const char* path, int type, int id, int k) {
+    int fd = connectTo(path);
+    if (fd < 0) {
+        std::cerr << "Could not connect to " << path << "\n";
+        return 1;
+    }
+
+    QueryRequest request;
+    request.requestId = 1;
+    request.type = type;
+    request.id = id;
+    request.k = k;
+
+    QueryRow rows[QUERY_MAX_K];
+    int status, count;
+    if (!roundTrip(fd, request, status, rows, count)) {
+        std::cerr << "Connection lost.\n";
+        ::close(fd);
+        return 1;
+    }
+    ::close(fd);
+
+    if (status != QUERY_OK) {
+        std::cout << statusName(status) << "\n";
+        return 1;
+    }
+    const char* label = (type == QUERY_CANDIDATES_FOR_JOB) ? "Resume ID" : "Job ID";
+    std::cout << std::left << std::setw(6) << "Rank" << " | " << std::setw(10) << label
+              << " | " << std::setw(7) << "Score%" << " | Skills\n";
+    for (int i = 0; i < count; i++) {
+        std::cout << std::left << std::setw(6) << (i + 1) << " | " << std::setw(10) << rows[i].id
+                  << " | " << std::fixed << std::setprecision(2) << std::setw(7) << rows[i].score
+                  << " | " << rows[i].matchedSkills << "\n";
+    }
+    return 0;
+}
+
+struct BenchWorker {
+    std::vector<long long> latenciesUs;
+    long long notFound = 0;
+    bool failed = false;
+};
+
+static void benchConnection(const char* path, int requests, int k, int maxId, unsigned seed,
+                            BenchWorker& out) {
+    int fd = connectTo(path);
+    if (fd < 0) {
+        out.failed = true;
+        return;
+    }
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> ids(1, maxId);
+    QueryRow rows[QUERY_MAX_K];
+    out.latenciesUs.reserve(requests);
+
+    for (int i = 0; i < requests; i++) {
+        QueryRequest request;
+        request.requestId = (unsigned int)i;
+        request.type = QUERY_CANDIDATES_FOR_JOB;
+        request.id = ids(rng);
+        request.k = k;
+
+        int status, count;
+        Clock::time_point t0 = Clock::now();
+        if (!roundTrip(fd, request, status, rows, count)) {
+            out.failed = true;
+            break;
+        }
+        out.latenciesUs.push_back(std::chrono::duration_cast<std::chrono::microseconds>(
+            Clock::now() - t0).count());
+        if (status == QUERY_NOT_FOUND) out.notFound++;
+    }
+    ::close(fd);
+}
+
+static long long percentile(const std::vector<long long>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    long long rank = (long long)(p * sorted.size() + 0.999999);
+    if (rank < 1) rank = 1;
+    if (rank > (long long)sorted.size()) rank = sorted.size();
+    return sorted[rank - 1];
+}
+
+static int runBench(const char* path, int connections, int requests, int k, int maxId) {
+    std::vector<BenchWorker> workers(connections);
+    std::vector<std::thread> threads;
+
+    Clock::time_point t0 = Clock::now();
+    for (int c = 0; c < connections; c++) {
+        threads.push_back(std::thread(benchConnection, path, requests, k, maxId,
+                                      1234u + (unsigned)c, std::ref(workers[c])));
+    }
+    for (size_t c = 0; c < threads.size(); c++) threads[c].join();
+    long long wallUs = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - t0).count();
+
+    std::vector<long long> all;
+    long long notFound = 0;
+    int failed = 0;
+    for (int c = 0; c < connections; c++) {
+        all.insert(all.end(), workers[c].latenciesUs.begin(), workers[c].latenciesUs.end());
+        notFound += workers[c].notFound;
+        if (workers[c].failed) failed++;
+    }
+    std::sort(all.begin(), all.end());
+
+    std::cout << "Connections : " << connections << "\n";
+    std::cout << "Requests    : " << all.size() << " (" << notFound << " not found)\n";
+    if (failed > 0) std::cout << "Failed      : " << failed << " connections\n";
+    std::cout << "Wall time   : " << std::fixed << std::setprecision(2) << wallUs / 1000.0 << " ms\n";
+    std::cout << "Throughput  : " << std::setprecision(0)
+              << (wallUs > 0 ? all.size() * 1000000.0 / wallUs : 0.0) << " requests/s\n";
+    std::cout << "Latency (us): p50 " << percentile(all, 0.50)
+              << "  p90 " << percentile(all, 0.90)
+              << "  p99 " << percentile(all, 0.99)
+              << "  p99.9 " << percentile(all, 0.999)
+              << "  max " << (all.empty() ? 0 : all.back()) << "\n";
+    return failed > 0 ? 1 : 0;
+}
+
+static int usage() {
+    std::cerr << "usage: query_client <socket> job <jobId> [k]\n"
+              << "       query_client <socket> resume <resumeId> [k]\n"
+              << "       query_client <socket> bench <connections> <requests> [k] [maxJobId]\n"
+              << "       query_client <socket> shutdown\n";
+    return 2;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) return usage();
+    const char* path = argv[1];
+    std::string mode = argv[2];
+
+    if ((mode == "job" || mode == "resume") && argc >= 4) {
+        int k = (argc >= 5) ? atoi(argv[4]) : 10;
+        int type = (mode == "job") ? QUERY_CANDIDATES_FOR_JOB : QUERY_JOBS_FOR_RESUME;
+        return runQuery(path, type, atoi(argv[3]), k);
+    }
+    if (mode == "bench" && argc >= 5) {
+        int connections = atoi(argv[3]);
+        int requests = atoi(argv[4]);
+        int k = (argc >= 6) ? atoi(argv[5]) : 10;
+        int maxId = (argc >= 7) ? atoi(argv[6]) : 10000;
+        if (connections < 1 || requests < 1 || maxId < 1) return usage();
+        return runBench(path, connections, requests, k, maxId);
+    }
+    if (mode == "shutdown") {
+        int fd = connectTo(path);
+        if (fd < 0) {
+            std::cerr << "Could not connect to " << path << "\n";
+            return 1;
+        }
+        QueryRequest request;
+        request.requestId = 1;
+        request.type = QUERY_SHUTDOWN;
+        QueryRow rows[QUERY_MAX_K];
+        int status, count;
+        bool ok = roundTrip(fd, request, status, rows, count) && status == QUERY_OK;
+        ::close(fd);
+        std::cout << (ok ? "Server is shutting down.\n" : "Shutdown failed.\n");
+        return ok ? 0 : 1;
+    }
+    return usage();
+}
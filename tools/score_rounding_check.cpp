@@ -0,0 +1,131 @@
+// Checks the fixed-point scores (score mode "Fixed point") against the
+// floating point scores as they are printed with two decimals.
+//
+// Build:  g++ -std=c++17 -O2 tools/score_rounding_check.cpp -o score_rounding_check
+//
+// Usage:  score_rounding_check
+//
+// For both scoring policies and every job with 1-64 skills, overlap 0..n,
+// required years 0-20 and actual years 0-40, the exact score in hundredths
+// is computed from the policy's fractions and rounded half to even.
+// ScoringCore::scoreHundredths and FixedScoreTables::score must both give
+// that value, and printf("%.2f") of the double score must print it too,
+// except on exact halves the double doesn't hold exactly: those are
+// counted and reported as the known gap, not failures. A few cases that
+// used to print differently are also checked by name.
+//
+// Exits with 1 if any check fails.
+
+#include "../src/shared/ScoringCore.hpp"
+#include <cstdio>
+#include <cstdlib>
+
+static int failures = 0;
+
+// Hundredths printed for a double score
+static long long printedHundredths(double score) {
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "%.2f", score);
+    long long whole = 0, part = 0;
+    const char* p = buffer;
+    while (*p && *p != '.') whole = whole * 10 + (*p++ - '0');
+    if (*p == '.') {
+        p++;
+        part = (p[0] - '0') * 10 + (p[1] - '0');
+    }
+    return whole * 100 + part;
+}
+
+template <typename Policy>
+static void checkPolicy(const char* name) {
+    static const FixedScoreTables<Policy> tables;
+    long long pairs = 0, halves = 0, gap = 0;
+    int shown = 0;
+
+    for (int n = 1; n <= 64; n++) {
+        for (int o = 0; o <= n; o++) {
+            int resumeSkills = o > 0 ? o : 1;
+            for (int required = 0; required <= 20; required++) {
+                for (int actual = 0; actual <= 40; actual++) {
+                    pairs++;
+
+                    // Exact score in hundredths: num / den
+                    int sn, sd, en, ed;
+                    Policy::skillFraction(o, n, sn, sd);
+                    Policy::experienceFraction(required, actual, en, ed);
+                    long long num = 100LL * Policy::SKILL_WEIGHT * sn * ed + 100LL * Policy::EXPERIENCE_WEIGHT * en * sd;
+                    long long den = (long long)sd * ed;
+                    long long expected = num / den;
+                    long long rest = 2 * (num % den);
+                    bool half = rest == den;
+                    if (rest > den || (half && (expected & 1))) expected++;
+                    if (half) halves++;
+
+                    int core = ScoringCore<Policy>::scoreHundredths(o, n, resumeSkills, required, actual);
+                    int table = tables.score(o, n, resumeSkills, required, actual);
+                    if (core != expected || table != expected) {
+                        std::printf("FAIL %s: n=%d o=%d required=%d actual=%d exact=%lld core=%d table=%d\n",
+                                    name, n, o, required, actual, expected, core, table);
+                        failures++;
+                    }
+
+                    double score = ScoringCore<Policy>::score(o, n, resumeSkills, required, actual);
+                    long long printed = printedHundredths(score);
+                    if (printed == expected) continue;
+
+                    // An exact half prints per the double's error unless the
+                    // double is the half itself (odd multiples of 1/8 only)
+                    long long twice = 2 * (num / den) + 1;      // half in two-hundredths
+                    bool exactInBinary = twice % 25 == 0 && score == twice / 200.0;
+                    if (half && !exactInBinary) {
+                        gap++;
+                        if (shown++ < 3) {
+                            std::printf("  gap %s: n=%d o=%d required=%d actual=%d prints %.2f, fixed %lld.%02lld\n",
+                                        name, n, o, required, actual, score, expected / 100, expected % 100);
+                        }
+                        continue;
+                    }
+                    std::printf("FAIL %s: n=%d o=%d required=%d actual=%d prints %.2f, fixed %lld.%02lld\n",
+                                name, n, o, required, actual, score, expected / 100, expected % 100);
+                    failures++;
+                }
+            }
+        }
+    }
+    std::printf("%s: %lld pairs, %lld exact halves, %lld print on the other side (double error)\n",
+                name, pairs, halves, gap);
+}
+
+// A case from the review of the fixed mode, by name
+template <typename Policy>
+static void expectFixed(const char* name, int overlap, int jobSkills, int required, int actual, int hundredths) {
+    static const FixedScoreTables<Policy> tables;
+    int resumeSkills = overlap > 0 ? overlap : 1;
+    int core = ScoringCore<Policy>::scoreHundredths(overlap, jobSkills, resumeSkills, required, actual);
+    int table = tables.score(overlap, jobSkills, resumeSkills, required, actual);
+    if (core != hundredths || table != hundredths) {
+        std::printf("FAIL %s: expected %d, core=%d table=%d\n", name, hundredths, core, table);
+        failures++;
+    }
+}
+
+int main() {
+    // 30 * 3/16 = 5.625 prints 5.62 (the double is exact)
+    expectFixed<ArrayScoringPolicy>("array, required 16, actual 3", 0, 4, 16, 3, 562);
+    // 70 * 1/16 + 30 * 3/16 = 10 exactly
+    expectFixed<ArrayScoringPolicy>("array, 1 of 16 skills, required 16, actual 3", 1, 16, 16, 3, 1000);
+    // 70 * 1/16 = 4.375 rounds to the even 4.38
+    expectFixed<ArrayScoringPolicy>("array, 1 of 16 skills, no experience", 1, 16, 16, 0, 438);
+    // 70 * 3/16 = 13.125 rounds to the even 13.12
+    expectFixed<ArrayScoringPolicy>("array, 3 of 16 skills, no experience", 3, 16, 16, 0, 1312);
+
+    checkPolicy<ArrayScoringPolicy>("array");
+    checkPolicy<LinkedListScoringPolicy>("linked list");
+
+    if (failures > 0) {
+        std::printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("All checks passed\n");
+    return 0;
+}